@@ -0,0 +1,275 @@
+#ifndef __ADJACENCY_ARRAY_H__
+#define __ADJACENCY_ARRAY_H__
+
+#include <cassert>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "graph.h"
+
+/*
+ * Dense index of a vertex inside a graph, in the range [0, vertexCount). Unlike
+ * vertex IDs, indices can be used to address per-vertex arrays directly. The
+ * compact graphs are templated on the ID type and the index type, so that graphs
+ * with fewer than 2^32 vertices can use 32-bit indices whatever their IDs are.
+ */
+using VertexIndex = std::uint32_t;
+
+template <typename Index>
+class BasicIndexRange {
+public:
+	BasicIndexRange(const Index* _first, const Index* _last): first(_first), last(_last) {}
+
+	const Index* begin() const { return first; }
+	const Index* end() const { return last; }
+
+	std::size_t size() const { return static_cast<std::size_t>(last - first); }
+	bool empty() const { return first == last; }
+
+private:
+	const Index* first;
+	const Index* last;
+};
+
+using IndexRange = BasicIndexRange<VertexIndex>;
+
+template <typename ID, typename Index>
+class BasicVertexIndexer {
+	static_assert(std::is_integral<ID>::value, "vertex IDs must be integers");
+	static_assert(std::is_unsigned<Index>::value, "vertex indices must be unsigned integers");
+
+public:
+	/*
+	 * Assign a dense index to every vertex ID mentioned by the edges. When the IDs
+	 * are reasonably compact, indices follow the order of the IDs and are looked up
+	 * in a table; otherwise they follow the order of first appearance and are
+	 * looked up in a hash map.
+	 *
+	 * @param edges the edges whose endpoints should be indexed
+	 */
+	explicit BasicVertexIndexer(const std::vector<BasicEdge<ID>>& edges);
+
+	std::size_t size() const { return ids.size(); }
+
+	/*
+	 * Check if the vertex ID has been assigned an index
+	 *
+	 * @param id the vertex ID to check
+	 * @return true if the ID appears in the indexed edges, false otherwise
+	 */
+	bool contains(ID id) const;
+
+	/*
+	 * @param id a vertex ID that must appear in the indexed edges
+	 * @return the dense index of the vertex
+	 */
+	Index indexOf(ID id) const;
+
+	/*
+	 * @param index a dense index in the range [0, size())
+	 * @return the ID of the vertex with the given index
+	 */
+	ID idOf(Index index) const { return ids[index]; }
+
+private:
+	static constexpr Index noIndex = std::numeric_limits<Index>::max();
+
+	static std::uint64_t distance(ID from, ID to)
+	{
+		return static_cast<std::uint64_t>(to) - static_cast<std::uint64_t>(from);
+	}
+
+	std::vector<ID> ids;
+	ID smallestID = 0;
+	std::vector<Index> denseIndices;
+	std::unordered_map<ID, Index> sparseIndices;
+};
+
+using VertexIndexer = BasicVertexIndexer<VertexID, VertexIndex>;
+
+enum class EdgeOrientation {
+	Directed,
+	Undirected
+};
+
+/*
+ * Compressed sparse row storage of arcs between dense vertex indices: the arcs
+ * leaving a vertex are stored contiguously, and one offset per vertex marks
+ * where they start.
+ */
+template <typename Index>
+class BasicAdjacencyArray {
+public:
+	BasicAdjacencyArray() = default;
+
+	/*
+	 * Store the arcs of a set of edges. A directed edge is stored as one arc from
+	 * its source to its target. An undirected edge is stored as an arc in each
+	 * direction, skipping self-loops and repeated edges as `UndirectedGraph` does.
+	 *
+	 * @param edges the edges to store
+	 * @param indexer the index of every vertex mentioned by the edges
+	 * @param orientation whether the edges are directed or undirected
+	 */
+	template <typename ID>
+	BasicAdjacencyArray(const std::vector<BasicEdge<ID>>& edges, const BasicVertexIndexer<ID, Index>& indexer,
+		                EdgeOrientation orientation);
+
+	std::size_t vertexCount() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+	std::size_t arcCount() const { return targets.size(); }
+
+	BasicIndexRange<Index> neighborsOf(Index index) const
+	{
+		return BasicIndexRange<Index>(targets.data() + offsets[index], targets.data() + offsets[index + 1]);
+	}
+
+private:
+	void removeRepeatedArcs();
+
+	std::vector<std::size_t> offsets;
+	std::vector<Index> targets;
+};
+
+using AdjacencyArray = BasicAdjacencyArray<VertexIndex>;
+
+
+template <typename ID, typename Index>
+constexpr Index BasicVertexIndexer<ID, Index>::noIndex;
+
+template <typename ID, typename Index>
+BasicVertexIndexer<ID, Index>::BasicVertexIndexer(const std::vector<BasicEdge<ID>>& edges)
+{
+	if (edges.empty())
+		return;
+
+	ID largestID = edges.front().source;
+	smallestID = largestID;
+	for (auto&& edge : edges) {
+		smallestID = std::min(smallestID, std::min(edge.source, edge.target));
+		largestID = std::max(largestID, std::max(edge.source, edge.target));
+	}
+
+	if (distance(smallestID, largestID) < 2 * edges.size() + 1024) {
+		auto idRange = static_cast<std::size_t>(distance(smallestID, largestID)) + 1;
+
+		denseIndices.assign(idRange, noIndex);
+		for (auto&& edge : edges) {
+			denseIndices[distance(smallestID, edge.source)] = 0;
+			denseIndices[distance(smallestID, edge.target)] = 0;
+		}
+
+		for (std::size_t offset = 0; offset < idRange; ++offset) {
+			if (noIndex == denseIndices[offset])
+				continue;
+
+			denseIndices[offset] = static_cast<Index>(ids.size());
+			ids.push_back(static_cast<ID>(static_cast<std::uint64_t>(smallestID) + offset));
+		}
+	}
+	else {
+		for (auto&& edge : edges) {
+			for (ID id : { edge.source, edge.target }) {
+				if (sparseIndices.emplace(id, static_cast<Index>(ids.size())).second)
+					ids.push_back(id);
+			}
+		}
+	}
+
+	assert(ids.size() < noIndex);
+}
+
+template <typename ID, typename Index>
+bool BasicVertexIndexer<ID, Index>::contains(ID id) const
+{
+	if (!denseIndices.empty()) {
+		return id >= smallestID && distance(smallestID, id) < denseIndices.size() &&
+			   noIndex != denseIndices[distance(smallestID, id)];
+	}
+
+	return sparseIndices.find(id) != sparseIndices.end();
+}
+
+template <typename ID, typename Index>
+Index BasicVertexIndexer<ID, Index>::indexOf(ID id) const
+{
+	assert(contains(id));
+
+	if (!denseIndices.empty())
+		return denseIndices[distance(smallestID, id)];
+
+	return sparseIndices.find(id)->second;
+}
+
+template <typename Index>
+template <typename ID>
+BasicAdjacencyArray<Index>::BasicAdjacencyArray(const std::vector<BasicEdge<ID>>& edges,
+	                                            const BasicVertexIndexer<ID, Index>& indexer,
+	                                            EdgeOrientation orientation)
+	: offsets(indexer.size() + 1, 0)
+{
+	bool undirected = EdgeOrientation::Undirected == orientation;
+
+	for (auto&& edge : edges) {
+		if (undirected && edge.source == edge.target)
+			continue;
+
+		++offsets[indexer.indexOf(edge.source) + 1];
+		if (undirected)
+			++offsets[indexer.indexOf(edge.target) + 1];
+	}
+
+	for (std::size_t i = 1; i < offsets.size(); ++i)
+		offsets[i] += offsets[i - 1];
+
+	targets.resize(offsets.back());
+
+	std::vector<std::size_t> nextSlot(offsets.begin(), offsets.end() - 1);
+	for (auto&& edge : edges) {
+		if (undirected && edge.source == edge.target)
+			continue;
+
+		auto source = indexer.indexOf(edge.source);
+		auto target = indexer.indexOf(edge.target);
+
+		targets[nextSlot[source]++] = target;
+		if (undirected)
+			targets[nextSlot[target]++] = source;
+	}
+
+	if (undirected)
+		removeRepeatedArcs();
+}
+
+template <typename Index>
+void BasicAdjacencyArray<Index>::removeRepeatedArcs()
+{
+	const auto notSeen = std::numeric_limits<Index>::max();
+	std::vector<Index> lastSeenFrom(vertexCount(), notSeen);
+	std::size_t kept = 0;
+
+	for (std::size_t vertex = 0; vertex < vertexCount(); ++vertex) {
+		auto first = offsets[vertex];
+		auto last = offsets[vertex + 1];
+		offsets[vertex] = kept;
+
+		for (auto arc = first; arc < last; ++arc) {
+			auto target = targets[arc];
+			if (lastSeenFrom[target] == static_cast<Index>(vertex))
+				continue;
+
+			lastSeenFrom[target] = static_cast<Index>(vertex);
+			targets[kept++] = target;
+		}
+	}
+
+	offsets[vertexCount()] = kept;
+	targets.resize(kept);
+	targets.shrink_to_fit();
+}
+
+#endif
@@ -0,0 +1,349 @@
+#ifndef __COMPACT_GRAPH_H__
+#define __COMPACT_GRAPH_H__
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "graph.h"
+#include "adjacency_array.h"
+#include "indexed_graph.h"
+
+/*
+ * An undirected graph stored as an adjacency array over dense vertex indices.
+ * It holds the same graph as `UndirectedGraph`, but needs only two indices per
+ * edge, and keeps no traversal state so that it can be shared between readers.
+ */
+template <typename ID, typename Index>
+class BasicCompactUndirectedGraph {
+public:
+	using id_type = ID;
+	using index_type = Index;
+	using edge_type = BasicEdge<ID>;
+
+	/*
+	 * Initialize an undirected graph from a set of edges. Self-loops and repeated
+	 * edges are ignored.
+	 *
+	 * @param edges the set of edges used to initialize the graph
+	 */
+	BasicCompactUndirectedGraph(const std::vector<edge_type>& edges)
+		: indexer(edges), adjacency(edges, indexer, EdgeOrientation::Undirected) {}
+
+	std::size_t vertexCount() const { return adjacency.vertexCount(); }
+	std::size_t edgeCount() const { return adjacency.arcCount() / 2; }
+
+	/*
+	 * Check if the graph contains a vertex with the given ID
+	 *
+	 * @param id the ID of the vertex to check
+	 * @return true if the vertex is present in the graph, false otherwise
+	 */
+	bool hasVertex(ID id) const { return indexer.contains(id); }
+
+	/*
+	 * @param id the ID of a vertex present in the graph
+	 * @return the dense index of the vertex, in the range [0, vertexCount())
+	 */
+	Index indexOf(ID id) const { return indexer.indexOf(id); }
+
+	/*
+	 * @param index the dense index of a vertex
+	 * @return the ID of the vertex
+	 */
+	ID idOf(Index index) const { return indexer.idOf(index); }
+
+	/*
+	 * This function returns the vertices that are directly connected to the given
+	 * vertex by an edge in the graph
+	 *
+	 * @param index the dense index of the vertex
+	 * @return the dense indices of the adjacent vertices
+	 */
+	BasicIndexRange<Index> neighborsOf(Index index) const { return adjacency.neighborsOf(index); }
+
+private:
+	BasicVertexIndexer<ID, Index> indexer;
+	BasicAdjacencyArray<Index> adjacency;
+};
+
+using CompactUndirectedGraph = BasicCompactUndirectedGraph<VertexID, VertexIndex>;
+
+template <typename Index>
+struct BasicTraversalEvent {
+	EdgeKind kind;
+	Index source;
+	Index target;
+};
+
+/*
+ * Receives the vertex events of a `CompactDepthFirstTraversal`, which reports
+ * edges through its events instead. This one ignores them, and observers that
+ * need only some of the events may derive from it.
+ */
+template <typename Index>
+struct NullSearchObserver {
+	/*
+	 * Called when the search enters a new component, before its root is discovered
+	 */
+	void startComponent(Index root) {}
+
+	/*
+	 * Called when a vertex is discovered, before the tree edge leading to it is
+	 * reported
+	 *
+	 * @param vertex the index of the vertex
+	 * @param degree the number of neighbors of the vertex
+	 */
+	void discoverVertex(Index vertex, std::size_t degree) {}
+
+	/*
+	 * Called when every neighbor of a vertex has been examined
+	 *
+	 * @param vertex the index of the vertex
+	 * @param parent the index of its parent in the search tree, or `noParent` for
+	 *        a root
+	 */
+	void finishVertex(Index vertex, Index parent) {}
+};
+
+/*
+ * The counterpart of `DepthFirstTraversal` for graphs over dense indices, i.e.
+ * any model of the indexed graph described in `indexed_graph.h`. The discovery
+ * state and parents live in arrays owned by the traversal rather than in the
+ * graph, so several traversals may run over the same graph at once.
+ *
+ * In a directed search, `neighborsOf` lists the successors of a vertex, and
+ * every edge leading back to a vertex on the stack is a back edge. In an
+ * undirected one, the edge leading back to the parent is not.
+ */
+template <typename Graph, EdgeOrientation orientation = EdgeOrientation::Undirected>
+class CompactDepthFirstTraversal {
+public:
+	using index_type = typename Graph::index_type;
+	using event_type = BasicTraversalEvent<index_type>;
+
+	static constexpr index_type noParent = std::numeric_limits<index_type>::max();
+
+	class iterator {
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = event_type;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const event_type*;
+		using reference = const event_type&;
+
+		iterator() = default;
+		explicit iterator(CompactDepthFirstTraversal* _traversal): traversal(_traversal)
+		{
+			if (traversal != nullptr && !traversal->next(event))
+				traversal = nullptr;
+		}
+
+		reference operator*() const { return event; }
+		pointer operator->() const { return &event; }
+
+		iterator& operator++()
+		{
+			assert(traversal != nullptr);
+
+			if (!traversal->next(event))
+				traversal = nullptr;
+
+			return *this;
+		}
+
+		iterator operator++(int)
+		{
+			auto previous = *this;
+			++(*this);
+
+			return previous;
+		}
+
+		bool operator==(const iterator& other) const { return traversal == other.traversal; }
+		bool operator!=(const iterator& other) const { return traversal != other.traversal; }
+
+	private:
+		CompactDepthFirstTraversal* traversal = nullptr;
+		event_type event;
+	};
+
+	/*
+	 * Prepare a depth-first search over every component of the graph, starting
+	 * each one from its undiscovered vertex with the smallest index
+	 *
+	 * @param graph the graph to search, which must outlive the traversal
+	 */
+	explicit CompactDepthFirstTraversal(const Graph& graph)
+		: CompactDepthFirstTraversal(graph, 0, true) {}
+
+	/*
+	 * Prepare a depth-first search of the component containing the source vertex
+	 *
+	 * @param graph the graph to search, which must outlive the traversal
+	 * @param source the index of the vertex from which to start the search
+	 */
+	CompactDepthFirstTraversal(const Graph& graph, index_type source)
+		: CompactDepthFirstTraversal(graph, source, false) {}
+
+	/*
+	 * Advance the search until the next tree edge or back edge is found
+	 *
+	 * @param event receives the edge that was found
+	 * @return true if an edge was found, false if the search is finished
+	 */
+	bool next(event_type& event)
+	{
+		NullSearchObserver<index_type> observer;
+		return next(event, observer);
+	}
+
+	/*
+	 * Same as above, but also notifies an observer of the vertices discovered and
+	 * finished on the way, with the interface of `NullSearchObserver`
+	 */
+	template <typename Observer>
+	bool next(event_type& event, Observer& observer);
+
+	bool isDiscovered(index_type vertex) const { return Undiscovered != states[vertex]; }
+	index_type parentOf(index_type vertex) const { return parents[vertex]; }
+
+	iterator begin() { return iterator(this); }
+	iterator end() { return iterator(); }
+
+private:
+	enum State : std::uint8_t { Undiscovered, OnStack, Finished };
+
+	struct Frame {
+		index_type vertex;
+		NeighborIterator<Graph> nextNeighbor;
+		NeighborIterator<Graph> lastNeighbor;
+	};
+
+	CompactDepthFirstTraversal(const Graph& _graph, index_type source, bool _allComponents)
+		: graph(_graph), allComponents(_allComponents), nextRoot(source),
+		  states(_graph.vertexCount(), Undiscovered), parents(_graph.vertexCount(), noParent)
+	{
+		assert(allComponents || source < graph.vertexCount());
+	}
+
+	template <typename Observer>
+	void discover(index_type vertex, Observer& observer)
+	{
+		auto neighbors = graph.neighborsOf(vertex);
+		states[vertex] = OnStack;
+		stack.push_back({ vertex, neighbors.begin(), neighbors.end() });
+
+		observer.discoverVertex(vertex, neighbors.size());
+	}
+
+	template <typename Observer>
+	bool discoverNextRoot(Observer& observer);
+
+	const Graph& graph;
+	bool allComponents;
+	std::size_t nextRoot;
+	std::vector<std::uint8_t> states;
+	std::vector<index_type> parents;
+	std::vector<Frame> stack;
+};
+
+/*
+ * Check if an undirected graph contains a cycle by searching it for a back edge
+ *
+ * @param graph the graph to check, a model of the indexed graph
+ * @return true if the graph contains a cycle, false otherwise
+ */
+template <typename Graph>
+typename std::enable_if<IsIndexedGraph<Graph>::value, bool>::type hasCycle(const Graph& graph)
+{
+	CompactDepthFirstTraversal<Graph> traversal(graph);
+	BasicTraversalEvent<typename Graph::index_type> event;
+
+	while (traversal.next(event)) {
+		if (EdgeKind::Back == event.kind)
+			return true;
+	}
+
+	return false;
+}
+
+
+template <typename Graph, EdgeOrientation orientation>
+constexpr typename Graph::index_type CompactDepthFirstTraversal<Graph, orientation>::noParent;
+
+/*
+ * A single-component search discovers its source here too, on the first call,
+ * so that the observer sees it.
+ */
+template <typename Graph, EdgeOrientation orientation>
+template <typename Observer>
+bool CompactDepthFirstTraversal<Graph, orientation>::discoverNextRoot(Observer& observer)
+{
+	while (nextRoot < graph.vertexCount() && Undiscovered != states[nextRoot]) {
+		if (!allComponents)
+			return false;
+		++nextRoot;
+	}
+
+	if (nextRoot >= graph.vertexCount())
+		return false;
+
+	auto root = static_cast<index_type>(nextRoot);
+	observer.startComponent(root);
+	discover(root, observer);
+
+	return true;
+}
+
+/*
+ * A neighbor that is still on the stack is an ancestor of the current vertex.
+ * Finished neighbors are descendants whose back edge has already been reported
+ * from their side. In an undirected search, self-loops and every arc back to
+ * the parent are skipped, however often they are listed.
+ */
+template <typename Graph, EdgeOrientation orientation>
+template <typename Observer>
+bool CompactDepthFirstTraversal<Graph, orientation>::next(event_type& event, Observer& observer)
+{
+	while (!stack.empty() || discoverNextRoot(observer)) {
+		auto& frame = stack.back();
+		auto currentVertex = frame.vertex;
+
+		if (frame.nextNeighbor == frame.lastNeighbor) {
+			states[currentVertex] = Finished;
+			stack.pop_back();
+
+			observer.finishVertex(currentVertex, parents[currentVertex]);
+			continue;
+		}
+
+		auto neighbor = *frame.nextNeighbor++;
+
+		if (EdgeOrientation::Undirected == orientation && neighbor == currentVertex)
+			continue;
+
+		if (Undiscovered == states[neighbor]) {
+			parents[neighbor] = currentVertex;
+			discover(neighbor, observer);
+
+			event = { EdgeKind::Tree, currentVertex, neighbor };
+			return true;
+		}
+
+		if (OnStack == states[neighbor] &&
+			(EdgeOrientation::Directed == orientation || parents[currentVertex] != neighbor)) {
+			event = { EdgeKind::Back, currentVertex, neighbor };
+			return true;
+		}
+	}
+
+	return false;
+}
+
+#endif
@@ -0,0 +1,8 @@
+#include "directed_graph.h"
+
+const std::size_t TopologicalSorter::parallelFrontierSize;
+
+TopologicalSorter::TopologicalSorter(unsigned _threadCount)
+	: threadCount(std::max(1u, _threadCount))
+{
+}
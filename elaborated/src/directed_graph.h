@@ -0,0 +1,237 @@
+#ifndef __DIRECTED_GRAPH_H__
+#define __DIRECTED_GRAPH_H__
+
+#include <atomic>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "graph.h"
+#include "adjacency_array.h"
+#include "compact_graph.h"
+
+template <typename ID, typename Index>
+class BasicDirectedGraph {
+public:
+	using id_type = ID;
+	using index_type = Index;
+	using edge_type = BasicEdge<ID>;
+
+	/*
+	 * Initialize a directed graph from a set of edges, each pointing from its
+	 * source to its target. Self-loops and repeated edges are kept.
+	 *
+	 * @param edges the set of edges used to initialize the graph
+	 */
+	BasicDirectedGraph(const std::vector<edge_type>& edges)
+		: indexer(edges), successors(edges, indexer, EdgeOrientation::Directed) {}
+
+	std::size_t vertexCount() const { return successors.vertexCount(); }
+	std::size_t edgeCount() const { return successors.arcCount(); }
+
+	/*
+	 * Check if the graph contains a vertex with the given ID
+	 *
+	 * @param id the ID of the vertex to check
+	 * @return true if the vertex is present in the graph, false otherwise
+	 */
+	bool hasVertex(ID id) const { return indexer.contains(id); }
+
+	/*
+	 * @param id the ID of a vertex present in the graph
+	 * @return the dense index of the vertex, in the range [0, vertexCount())
+	 */
+	Index indexOf(ID id) const { return indexer.indexOf(id); }
+
+	/*
+	 * @param index the dense index of a vertex
+	 * @return the ID of the vertex
+	 */
+	ID idOf(Index index) const { return indexer.idOf(index); }
+
+	/*
+	 * This function returns the vertices that the given vertex has an edge to
+	 *
+	 * @param index the dense index of the vertex
+	 * @return the dense indices of the successors of the vertex
+	 */
+	BasicIndexRange<Index> successorsOf(Index index) const { return successors.neighborsOf(index); }
+
+private:
+	BasicVertexIndexer<ID, Index> indexer;
+	BasicAdjacencyArray<Index> successors;
+};
+
+using DirectedGraph = BasicDirectedGraph<VertexID, VertexIndex>;
+
+/*
+ * Check if a directed graph contains a cycle, using a directed
+ * `CompactDepthFirstTraversal` of its successors. An edge leading to a vertex
+ * still on the stack closes a cycle. Runs in O(V+E).
+ *
+ * @param graph the graph to check
+ * @return true if the graph contains a cycle, false otherwise
+ */
+template <typename ID, typename Index>
+bool hasCycle(const BasicDirectedGraph<ID, Index>& graph);
+
+template <typename ID>
+struct BasicTopologicalOrder {
+	bool hasCycle;
+
+	/*
+	 * The IDs of the vertices in topological order. When the graph contains a
+	 * cycle, the vertices on a cycle or reachable from one are missing.
+	 */
+	std::vector<ID> order;
+};
+
+using TopologicalOrder = BasicTopologicalOrder<VertexID>;
+
+class TopologicalSorter {
+public:
+	/*
+	 * @param threadCount the number of threads used to process large frontiers
+	 */
+	explicit TopologicalSorter(unsigned threadCount = std::thread::hardware_concurrency());
+
+	/*
+	 * Sort the vertices of a directed graph with Kahn's algorithm. Vertices are
+	 * released level by level: every vertex whose predecessors have all been
+	 * ordered joins the next frontier. Large frontiers are split between threads,
+	 * which decrement the remaining in-degrees atomically. Runs in O(V+E).
+	 *
+	 * @param graph the graph to sort
+	 * @return whether the graph contains a cycle, along with the ordering
+	 */
+	template <typename ID, typename Index>
+	BasicTopologicalOrder<ID> sort(const BasicDirectedGraph<ID, Index>& graph) const;
+
+	/*
+	 * Frontiers with fewer vertices than this are processed on the calling thread
+	 */
+	static const std::size_t parallelFrontierSize = 1 << 14;
+
+private:
+	template <typename ID, typename Index>
+	static void releaseSuccessors(const BasicDirectedGraph<ID, Index>& graph, const Index* first, const Index* last,
+		                          std::atomic<Index>* inDegrees, std::vector<Index>& released);
+
+	unsigned threadCount;
+};
+
+
+/*
+ * Presents the successors of every vertex of a directed graph as its neighbors,
+ * so that a directed `CompactDepthFirstTraversal` can search it
+ */
+template <typename Graph>
+class SuccessorView {
+public:
+	using index_type = typename Graph::index_type;
+
+	explicit SuccessorView(const Graph& _graph): graph(_graph) {}
+
+	std::size_t vertexCount() const { return graph.vertexCount(); }
+	BasicIndexRange<index_type> neighborsOf(index_type index) const { return graph.successorsOf(index); }
+
+private:
+	const Graph& graph;
+};
+
+template <typename ID, typename Index>
+bool hasCycle(const BasicDirectedGraph<ID, Index>& graph)
+{
+	using View = SuccessorView<BasicDirectedGraph<ID, Index>>;
+
+	View successors(graph);
+	CompactDepthFirstTraversal<View, EdgeOrientation::Directed> traversal(successors);
+	BasicTraversalEvent<Index> event;
+
+	while (traversal.next(event)) {
+		if (EdgeKind::Back == event.kind)
+			return true;
+	}
+
+	return false;
+}
+
+template <typename ID, typename Index>
+void TopologicalSorter::releaseSuccessors(const BasicDirectedGraph<ID, Index>& graph, const Index* first,
+	                                      const Index* last, std::atomic<Index>* inDegrees,
+	                                      std::vector<Index>& released)
+{
+	for (auto vertex = first; vertex != last; ++vertex) {
+		for (Index successor : graph.successorsOf(*vertex)) {
+			if (1 == inDegrees[successor].fetch_sub(1, std::memory_order_acq_rel))
+				released.push_back(successor);
+		}
+	}
+}
+
+template <typename ID, typename Index>
+BasicTopologicalOrder<ID> TopologicalSorter::sort(const BasicDirectedGraph<ID, Index>& graph) const
+{
+	auto vertexCount = graph.vertexCount();
+	std::unique_ptr<std::atomic<Index>[]> inDegrees(new std::atomic<Index>[vertexCount]);
+
+	for (Index vertex = 0; vertex < vertexCount; ++vertex)
+		inDegrees[vertex].store(0, std::memory_order_relaxed);
+
+	for (Index vertex = 0; vertex < vertexCount; ++vertex) {
+		for (Index successor : graph.successorsOf(vertex))
+			inDegrees[successor].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	std::vector<Index> ordered;
+	ordered.reserve(vertexCount);
+
+	std::vector<Index> frontier;
+	for (Index vertex = 0; vertex < vertexCount; ++vertex) {
+		if (0 == inDegrees[vertex].load(std::memory_order_relaxed))
+			frontier.push_back(vertex);
+	}
+
+	std::vector<std::vector<Index>> released(threadCount);
+
+	while (!frontier.empty()) {
+		ordered.insert(ordered.end(), frontier.begin(), frontier.end());
+
+		std::size_t chunkCount = frontier.size() < parallelFrontierSize ? 1 : threadCount;
+		std::size_t chunkSize = (frontier.size() + chunkCount - 1) / chunkCount;
+		std::vector<std::thread> workers;
+
+		for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+			auto first = frontier.data() + std::min(frontier.size(), chunk * chunkSize);
+			auto last = frontier.data() + std::min(frontier.size(), (chunk + 1) * chunkSize);
+			auto& output = released[chunk];
+			output.clear();
+
+			if (1 == chunkCount)
+				releaseSuccessors(graph, first, last, inDegrees.get(), output);
+			else
+				workers.emplace_back(releaseSuccessors<ID, Index>, std::cref(graph), first, last,
+					                 inDegrees.get(), std::ref(output));
+		}
+
+		for (auto&& worker : workers)
+			worker.join();
+
+		frontier.clear();
+		for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+			frontier.insert(frontier.end(), released[chunk].begin(), released[chunk].end());
+	}
+
+	BasicTopologicalOrder<ID> result;
+	result.hasCycle = ordered.size() != vertexCount;
+	result.order.reserve(ordered.size());
+
+	for (Index vertex : ordered)
+		result.order.push_back(graph.idOf(vertex));
+
+	return result;
+}
+
+#endif
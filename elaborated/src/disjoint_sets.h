@@ -0,0 +1,71 @@
+#ifndef __DISJOINT_SETS_H__
+#define __DISJOINT_SETS_H__
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/*
+ * A union-find structure over the elements [0, size), using union by rank and
+ * path halving. It needs one element plus one byte per element.
+ */
+template <typename Element>
+class BasicDisjointSets {
+public:
+	explicit BasicDisjointSets(std::size_t size)
+		: parent(size), rank(size, 0)
+	{
+		for (std::size_t i = 0; i < size; ++i)
+			parent[i] = static_cast<Element>(i);
+	}
+
+	Element find(Element element)
+	{
+		assert(element < parent.size());
+
+		while (parent[element] != element) {
+			parent[element] = parent[parent[element]];
+			element = parent[element];
+		}
+
+		return element;
+	}
+
+	/*
+	 * Merge the sets containing the two elements
+	 *
+	 * @return false if both elements were already in the same set, true otherwise
+	 */
+	bool unite(Element lhs, Element rhs)
+	{
+		auto lhsRoot = find(lhs);
+		auto rhsRoot = find(rhs);
+
+		if (lhsRoot == rhsRoot)
+			return false;
+
+		if (rank[lhsRoot] < rank[rhsRoot])
+			std::swap(lhsRoot, rhsRoot);
+
+		parent[rhsRoot] = lhsRoot;
+		if (rank[lhsRoot] == rank[rhsRoot])
+			++rank[lhsRoot];
+
+		return true;
+	}
+
+	static const std::size_t bytesPerElement = sizeof(Element) + sizeof(std::uint8_t);
+
+private:
+	std::vector<Element> parent;
+	std::vector<std::uint8_t> rank;
+};
+
+template <typename Element>
+const std::size_t BasicDisjointSets<Element>::bytesPerElement;
+
+using DisjointSets = BasicDisjointSets<std::uint32_t>;
+
+#endif
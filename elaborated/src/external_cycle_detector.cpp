@@ -0,0 +1,291 @@
+#include "external_cycle_detector.h"
+#include <cassert>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+using FilePtr = std::unique_ptr<std::FILE, int(*)(std::FILE*)>;
+
+const VertexID noAnchor = -1;
+
+FilePtr openEdgeFile(const std::string& path)
+{
+	FilePtr file(std::fopen(path.c_str(), "rb"), &std::fclose);
+	if (nullptr == file)
+		throw std::runtime_error("failed to open edge file " + path);
+
+	return file;
+}
+
+void checkEdge(const Edge& edge, std::size_t vertexCount)
+{
+	if (edge.source < 0 || edge.target < 0 ||
+		static_cast<std::size_t>(edge.source) >= vertexCount ||
+		static_cast<std::size_t>(edge.target) >= vertexCount)
+		throw std::out_of_range("edge file contains a vertex ID outside of [0, vertexCount)");
+}
+
+bool isWithin(VertexID id, std::size_t low, std::size_t high)
+{
+	return static_cast<std::size_t>(id) >= low && static_cast<std::size_t>(id) < high;
+}
+
+}
+
+EdgeFileReader::EdgeFileReader(std::FILE* _file, std::size_t _blockSize)
+	: file(_file), blockSize(_blockSize)
+{
+	assert(file != nullptr);
+	assert(blockSize > 0);
+
+	readAhead();
+}
+
+EdgeFileReader::~EdgeFileReader()
+{
+	if (pendingRead.valid())
+		pendingRead.wait();
+}
+
+void EdgeFileReader::readAhead()
+{
+	pending.resize(blockSize);
+
+	pendingRead = std::async(std::launch::async, [this]() {
+		auto count = std::fread(pending.data(), sizeof(Edge), pending.size(), file);
+		if (count < pending.size() && std::ferror(file))
+			throw std::runtime_error("failed to read edge file");
+
+		pending.resize(count);
+	});
+}
+
+const std::vector<Edge>& EdgeFileReader::nextBlock()
+{
+	if (!pendingRead.valid()) {
+		current.clear();
+		return current;
+	}
+
+	pendingRead.get();
+	std::swap(current, pending);
+
+	if (!current.empty())
+		readAhead();
+
+	return current;
+}
+
+EdgeFileWriter::EdgeFileWriter(std::FILE* _file, std::size_t blockSize)
+	: file(_file)
+{
+	assert(file != nullptr);
+	assert(blockSize > 0);
+
+	buffer.reserve(blockSize);
+}
+
+void EdgeFileWriter::write(const Edge& edge)
+{
+	buffer.push_back(edge);
+
+	if (buffer.size() == buffer.capacity())
+		flush();
+}
+
+std::size_t EdgeFileWriter::flush()
+{
+	if (std::fwrite(buffer.data(), sizeof(Edge), buffer.size(), file) != buffer.size())
+		throw std::runtime_error("failed to write edge file");
+
+	written += buffer.size();
+	buffer.clear();
+
+	return written;
+}
+
+std::vector<Edge> readEdgeFile(const std::string& path)
+{
+	auto file = openEdgeFile(path);
+	std::vector<Edge> edges;
+
+	EdgeFileReader reader(file.get(), std::size_t(1) << 20);
+	for (auto* block = &reader.nextBlock(); !block->empty(); block = &reader.nextBlock())
+		edges.insert(edges.end(), block->begin(), block->end());
+
+	return edges;
+}
+
+ExternalCycleDetector::ExternalCycleDetector(std::size_t _memoryBudget, std::size_t _blockSize)
+	: memoryBudget(_memoryBudget), blockSize(_blockSize)
+{
+	assert(blockSize > 0);
+}
+
+bool ExternalCycleDetector::hasCycle(const std::string& path, std::size_t vertexCount)
+{
+	passes = 0;
+	auto file = openEdgeFile(path);
+
+	if (vertexCount * DisjointSets::bytesPerElement <= memoryBudget)
+		return singlePassHasCycle(file.get(), vertexCount);
+
+	return partitionedHasCycle(file.get(), vertexCount);
+}
+
+bool ExternalCycleDetector::hasCycle(const std::string& path)
+{
+	passes = 0;
+	auto file = openEdgeFile(path);
+	auto vertexCount = scanVertexCount(file.get());
+
+	if (vertexCount * DisjointSets::bytesPerElement <= memoryBudget)
+		return singlePassHasCycle(file.get(), vertexCount);
+
+	return partitionedHasCycle(file.get(), vertexCount);
+}
+
+std::size_t ExternalCycleDetector::scanVertexCount(std::FILE* file)
+{
+	++passes;
+	std::rewind(file);
+
+	VertexID maxID = -1;
+	EdgeFileReader reader(file, blockSize);
+
+	for (auto* block = &reader.nextBlock(); !block->empty(); block = &reader.nextBlock()) {
+		for (auto&& edge : *block) {
+			if (edge.source < 0 || edge.target < 0)
+				throw std::out_of_range("edge file contains a negative vertex ID");
+
+			maxID = std::max(maxID, std::max(edge.source, edge.target));
+		}
+	}
+
+	return static_cast<std::size_t>(maxID + 1);
+}
+
+bool ExternalCycleDetector::singlePassHasCycle(std::FILE* file, std::size_t vertexCount)
+{
+	DisjointSets sets(vertexCount);
+
+	return unitePartition(file, sets, 0, vertexCount, vertexCount);
+}
+
+/*
+ * Each partition is contracted away before moving on to the next one: the
+ * edges inside the partition are merged into trees, and every tree that is
+ * connected to later partitions is folded into the endpoint of the first such
+ * edge (its anchor). Contracting trees preserves cycles, so once the last
+ * partition is reached only edges inside it are left to check.
+ */
+bool ExternalCycleDetector::partitionedHasCycle(std::FILE* file, std::size_t vertexCount)
+{
+	const std::size_t bytesPerVertex = DisjointSets::bytesPerElement + sizeof(VertexID);
+	const std::size_t partitionSize = std::max<std::size_t>(1, memoryBudget / bytesPerVertex);
+
+	std::FILE* input = file;
+	FilePtr contracted(nullptr, &std::fclose);
+
+	for (std::size_t low = 0; low < vertexCount; low += partitionSize) {
+		auto high = std::min(vertexCount, low + partitionSize);
+		DisjointSets sets(high - low);
+
+		if (unitePartition(input, sets, low, high, vertexCount))
+			return true;
+
+		if (high == vertexCount)
+			break;
+
+		FilePtr next(std::tmpfile(), &std::fclose);
+		if (nullptr == next)
+			throw std::runtime_error("failed to create temporary edge file");
+
+		std::size_t remainingEdges = 0;
+		if (contractPartition(input, next.get(), sets, low, high, remainingEdges))
+			return true;
+
+		if (0 == remainingEdges)
+			break;
+
+		contracted = std::move(next);
+		input = contracted.get();
+	}
+
+	return false;
+}
+
+bool ExternalCycleDetector::unitePartition(std::FILE* input, DisjointSets& sets,
+	                                       std::size_t low, std::size_t high, std::size_t vertexCount)
+{
+	++passes;
+	std::rewind(input);
+
+	EdgeFileReader reader(input, blockSize);
+
+	for (auto* block = &reader.nextBlock(); !block->empty(); block = &reader.nextBlock()) {
+		for (auto&& edge : *block) {
+			checkEdge(edge, vertexCount);
+
+			if (edge.source == edge.target)
+				continue;
+
+			if (!isWithin(edge.source, low, high) || !isWithin(edge.target, low, high))
+				continue;
+
+			if (!sets.unite(static_cast<std::uint32_t>(edge.source - low),
+				            static_cast<std::uint32_t>(edge.target - low)))
+				return true;
+		}
+	}
+
+	return false;
+}
+
+bool ExternalCycleDetector::contractPartition(std::FILE* input, std::FILE* output, DisjointSets& sets,
+	                                          std::size_t low, std::size_t high, std::size_t& remainingEdges)
+{
+	++passes;
+	std::rewind(input);
+
+	std::vector<VertexID> anchors(high - low, noAnchor);
+	EdgeFileReader reader(input, blockSize);
+	EdgeFileWriter writer(output, blockSize);
+
+	for (auto* block = &reader.nextBlock(); !block->empty(); block = &reader.nextBlock()) {
+		for (auto&& edge : *block) {
+			bool sourceWithin = isWithin(edge.source, low, high);
+			bool targetWithin = isWithin(edge.target, low, high);
+
+			if (edge.source == edge.target || (sourceWithin && targetWithin))
+				continue;
+
+			if (!sourceWithin && !targetWithin) {
+				writer.write(edge);
+				continue;
+			}
+
+			auto inside = sourceWithin ? edge.source : edge.target;
+			auto outside = sourceWithin ? edge.target : edge.source;
+			auto& anchor = anchors[sets.find(static_cast<std::uint32_t>(inside - low))];
+
+			if (noAnchor == anchor) {
+				anchor = outside;
+				continue;
+			}
+
+			if (anchor == outside)
+				return true;
+
+			writer.write({ anchor, outside });
+		}
+	}
+
+	remainingEdges = writer.flush();
+	std::fflush(output);
+
+	return false;
+}
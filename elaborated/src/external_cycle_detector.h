@@ -0,0 +1,132 @@
+#ifndef __EXTERNAL_CYCLE_DETECTOR_H__
+#define __EXTERNAL_CYCLE_DETECTOR_H__
+
+#include <cstdio>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "graph.h"
+#include "disjoint_sets.h"
+
+/*
+ * Edge files are flat binary arrays of `Edge` records, i.e. pairs of native-endian
+ * 32-bit vertex IDs. Vertex IDs must lie in the range [0, vertexCount).
+ */
+
+class EdgeFileReader {
+public:
+	/*
+	 * Start streaming edges from an open file. The next block is read in the
+	 * background while the caller processes the current one.
+	 *
+	 * @param file the file to read from, positioned at the first edge
+	 * @param blockSize the number of edges read from disk at once
+	 */
+	EdgeFileReader(std::FILE* file, std::size_t blockSize);
+	~EdgeFileReader();
+
+	EdgeFileReader(const EdgeFileReader&) = delete;
+	EdgeFileReader& operator=(const EdgeFileReader&) = delete;
+
+	/*
+	 * Retrieve the next block of edges from the file
+	 *
+	 * @return the next block of edges, which stays valid until the following call,
+	 *         or an empty block once the end of the file has been reached
+	 */
+	const std::vector<Edge>& nextBlock();
+
+private:
+	void readAhead();
+
+	std::FILE* file;
+	std::size_t blockSize;
+	std::vector<Edge> current;
+	std::vector<Edge> pending;
+	std::future<void> pendingRead;
+};
+
+class EdgeFileWriter {
+public:
+	EdgeFileWriter(std::FILE* file, std::size_t blockSize);
+
+	EdgeFileWriter(const EdgeFileWriter&) = delete;
+	EdgeFileWriter& operator=(const EdgeFileWriter&) = delete;
+
+	void write(const Edge& edge);
+
+	/*
+	 * Write out all buffered edges. This must be called once writing is done.
+	 *
+	 * @return the number of edges written so far
+	 */
+	std::size_t flush();
+
+private:
+	std::FILE* file;
+	std::vector<Edge> buffer;
+	std::size_t written = 0;
+};
+
+/*
+ * Load every edge of an edge file into memory
+ *
+ * @param path the edge file to read
+ * @return the edges in the order they appear in the file
+ */
+std::vector<Edge> readEdgeFile(const std::string& path);
+
+class ExternalCycleDetector {
+public:
+	/*
+	 * @param memoryBudget the number of bytes the detector may spend on per-vertex state
+	 * @param blockSize the number of edges read from or written to disk at once
+	 */
+	explicit ExternalCycleDetector(std::size_t memoryBudget = std::size_t(1) << 30,
+		                           std::size_t blockSize = std::size_t(1) << 20);
+
+	/*
+	 * Check whether the undirected graph stored in an edge file contains a cycle,
+	 * without loading its edges into memory. Self-loops are ignored, as in
+	 * `UndirectedGraph`. Since repeated edges cannot be told apart from cycles
+	 * without remembering the edges, the file is expected to hold each edge once.
+	 *
+	 * When the union-find array for all vertices fits in the memory budget, the file
+	 * is read exactly once. Otherwise the vertices are split into partitions that
+	 * fit, and the graph is contracted partition by partition into temporary files,
+	 * reading the edges at most twice per partition.
+	 *
+	 * @param path the edge file to check
+	 * @param vertexCount one past the largest vertex ID in the file
+	 * @return true if the graph contains a cycle, false otherwise
+	 */
+	bool hasCycle(const std::string& path, std::size_t vertexCount);
+
+	/*
+	 * Same as above, but determines the vertex count with an additional pass
+	 * over the file.
+	 */
+	bool hasCycle(const std::string& path);
+
+	/*
+	 * @return the number of sequential passes over edge data made by the last check
+	 */
+	std::size_t passCount() const { return passes; }
+
+private:
+	std::size_t scanVertexCount(std::FILE* file);
+	bool singlePassHasCycle(std::FILE* file, std::size_t vertexCount);
+	bool partitionedHasCycle(std::FILE* file, std::size_t vertexCount);
+	bool unitePartition(std::FILE* input, DisjointSets& sets, std::size_t low, std::size_t high,
+		                std::size_t vertexCount);
+	bool contractPartition(std::FILE* input, std::FILE* output, DisjointSets& sets,
+		                   std::size_t low, std::size_t high, std::size_t& remainingEdges);
+
+	std::size_t memoryBudget;
+	std::size_t blockSize;
+	std::size_t passes = 0;
+};
+
+#endif
@@ -51,6 +51,7 @@ bool Vertex::isParentOf(const shared_vertex other)
 void Vertex::reset()
 {
 	bDiscovered = false;
+	bFinished = false;
 	parent = nullptr;
 }
 
@@ -134,50 +135,108 @@ void UndirectedGraph::resetVertices() {
 		v->reset();
 }
 
-DepthFirstVisitor::DepthFirstVisitor()
+DepthFirstTraversal::iterator::iterator(DepthFirstTraversal* _traversal)
+	: traversal(_traversal)
 {
-	treeEdgeExaminer = [](const shared_vertex source, const shared_vertex target) {};
-	backEdgeExaminer = [](const shared_vertex source, const shared_vertex target) {};
+	if (traversal != nullptr && !traversal->next(event))
+		traversal = nullptr;
 }
 
-void DepthFirstVisitor::registerTreeEdgeExaminer(EdgeExaminer examiner)
+DepthFirstTraversal::iterator& DepthFirstTraversal::iterator::operator++()
 {
-	treeEdgeExaminer = examiner;
+	assert(traversal != nullptr);
+
+	if (!traversal->next(event))
+		traversal = nullptr;
+
+	return *this;
 }
 
-void DepthFirstVisitor::registerBackEdgeExaminer(EdgeExaminer examiner)
+DepthFirstTraversal::iterator DepthFirstTraversal::iterator::operator++(int)
 {
-	backEdgeExaminer = examiner;
+	auto previous = *this;
+	++(*this);
+
+	return previous;
 }
 
-void DepthFirstVisitor::search(UndirectedGraph& graph, shared_vertex source)
+DepthFirstTraversal::DepthFirstTraversal(UndirectedGraph& _graph, shared_vertex source)
+	: graph(_graph)
 {
 	assert(graph.hasVertex(source));
-	graph.resetVertices();
+	_graph.resetVertices();
 
-	recurSearch(graph, source);
+	discover(source);
 }
 
-void DepthFirstVisitor::recurSearch(UndirectedGraph& graph, shared_vertex currentVertex)
+void DepthFirstTraversal::discover(shared_vertex vertex)
 {
-	currentVertex->labelAsDiscovered();
+	vertex->labelAsDiscovered();
+
+	auto& neighbors = graph.adjacentVerticesOf(vertex);
+	stack.push_back({ vertex, neighbors.cbegin(), neighbors.cend() });
+}
+
+/*
+ * A discovered neighbor that is not finished yet is still on the stack, hence
+ * an ancestor of the current vertex. Finished neighbors are descendants whose
+ * back edge has already been reported from their side.
+ */
+bool DepthFirstTraversal::next(TraversalEvent& event)
+{
+	while (!stack.empty()) {
+		auto& frame = stack.back();
+
+		if (frame.nextNeighbor == frame.lastNeighbor) {
+			frame.vertex->labelAsFinished();
+			stack.pop_back();
+			continue;
+		}
+
+		auto currentVertex = frame.vertex;
+		auto neighbor = *frame.nextNeighbor++;
 
-	for (shared_vertex neighbor : graph.adjacentVerticesOf(currentVertex)) {
 		if (!neighbor->isDiscovered()) {
 			neighbor->setParent(currentVertex);
-			treeEdgeExaminer(currentVertex, neighbor);
+			discover(neighbor);
 
-			recurSearch(graph, neighbor);
+			event = { EdgeKind::Tree, currentVertex, neighbor };
+			return true;
 		}
 
-		examineBackEdgeIfFound(currentVertex, neighbor);
+		if (!neighbor->isFinished() && !neighbor->isParentOf(currentVertex)) {
+			event = { EdgeKind::Back, currentVertex, neighbor };
+			return true;
+		}
 	}
+
+	return false;
+}
+
+DepthFirstVisitor::DepthFirstVisitor()
+{
+	treeEdgeExaminer = [](const shared_vertex source, const shared_vertex target) {};
+	backEdgeExaminer = [](const shared_vertex source, const shared_vertex target) {};
+}
+
+void DepthFirstVisitor::registerTreeEdgeExaminer(EdgeExaminer examiner)
+{
+	treeEdgeExaminer = examiner;
 }
 
-void DepthFirstVisitor::examineBackEdgeIfFound(shared_vertex currentVertex, shared_vertex neighbor)
+void DepthFirstVisitor::registerBackEdgeExaminer(EdgeExaminer examiner)
 {
-	bool foundBackEdge = !neighbor->isParentOf(currentVertex) && isAncestor(neighbor, currentVertex);
-	if(foundBackEdge)
-		backEdgeExaminer(currentVertex, neighbor);
+	backEdgeExaminer = examiner;
 }
 
+void DepthFirstVisitor::search(UndirectedGraph& graph, shared_vertex source)
+{
+	DepthFirstTraversal traversal(graph, source);
+
+	for (auto&& event : traversal) {
+		if (EdgeKind::Tree == event.kind)
+			treeEdgeExaminer(event.source, event.target);
+		else
+			backEdgeExaminer(event.source, event.target);
+	}
+}
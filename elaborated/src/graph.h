@@ -6,6 +6,8 @@
 #include <memory>
 #include <map>
 #include <functional>
+#include <iterator>
+#include <cstddef>
 
 class Vertex;
 
@@ -14,11 +16,14 @@ using shared_vertex = std::shared_ptr<Vertex>;
 
 bool isAncestor(const shared_vertex ancestor, const shared_vertex decendant);
 
-struct Edge {
-	VertexID source;
-	VertexID target;
+template <typename ID>
+struct BasicEdge {
+	ID source;
+	ID target;
 };
 
+using Edge = BasicEdge<VertexID>;
+
 class Vertex {
 public:
 	Vertex(VertexID _id): id(_id) {}
@@ -28,6 +33,9 @@ public:
 	bool isDiscovered() const { return bDiscovered; }
 	void labelAsDiscovered() { bDiscovered = true; }
 
+	bool isFinished() const { return bFinished; }
+	void labelAsFinished() { bFinished = true; }
+
 	void setParent(const shared_vertex parent);
 	shared_vertex getParent() const;
 	bool isParentOf(const shared_vertex other);
@@ -36,6 +44,7 @@ public:
 
 private:
 	bool bDiscovered = false;
+	bool bFinished = false;
 	VertexID id;
 
 	shared_vertex parent = nullptr;
@@ -103,6 +112,93 @@ private:
 	std::map<shared_vertex, std::set<shared_vertex>> adjacencyList;
 };
 
+enum class EdgeKind {
+	Tree,
+	Back
+};
+
+struct TraversalEvent {
+	EdgeKind kind;
+	shared_vertex source;
+	shared_vertex target;
+};
+
+class DepthFirstTraversal {
+public:
+	/*
+	 * An input iterator over the remaining events of a traversal. Like
+	 * `std::istream_iterator`, it pulls an event as soon as it is created or
+	 * incremented.
+	 */
+	class iterator {
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = TraversalEvent;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const TraversalEvent*;
+		using reference = const TraversalEvent&;
+
+		iterator() = default;
+		explicit iterator(DepthFirstTraversal* traversal);
+
+		reference operator*() const { return event; }
+		pointer operator->() const { return &event; }
+
+		iterator& operator++();
+		iterator operator++(int);
+
+		bool operator==(const iterator& other) const { return traversal == other.traversal; }
+		bool operator!=(const iterator& other) const { return traversal != other.traversal; }
+
+	private:
+		DepthFirstTraversal* traversal = nullptr;
+		TraversalEvent event;
+	};
+
+	/*
+	 * Prepare a depth-first search (DFS) on the graph starting from the given
+	 * source vertex. Only the source is labelled as discovered when the traversal
+	 * is constructed; the rest of the graph is explored as events are requested,
+	 * and the search can be paused and resumed between any two events.
+	 *
+	 * The traversal labels the vertices of the graph, so the graph must outlive
+	 * it and must not be searched by anyone else in the meantime.
+	 *
+	 * @param graph the graph on which to perform the depth-first search
+	 * @param source the vertex from which to start the search, which must be
+	 *        present in the provided graph
+	 */
+	DepthFirstTraversal(UndirectedGraph& graph, shared_vertex source);
+
+	/*
+	 * Advance the search until the next tree edge or back edge is found
+	 *
+	 * @param event receives the edge that was found
+	 * @return true if an edge was found, false if the search is finished
+	 */
+	bool next(TraversalEvent& event);
+
+	/*
+	 * @return true if every vertex reachable from the source has been finished
+	 */
+	bool isFinished() const { return stack.empty(); }
+
+	iterator begin() { return iterator(this); }
+	iterator end() { return iterator(); }
+
+private:
+	struct Frame {
+		shared_vertex vertex;
+		std::set<shared_vertex>::const_iterator nextNeighbor;
+		std::set<shared_vertex>::const_iterator lastNeighbor;
+	};
+
+	void discover(shared_vertex vertex);
+
+	const UndirectedGraph& graph;
+	std::vector<Frame> stack;
+};
+
 class DepthFirstVisitor {
 public:
 	using EdgeExaminer = std::function<void(const shared_vertex source, const shared_vertex target)>;
@@ -142,9 +238,6 @@ public:
 	void search(UndirectedGraph& graph, shared_vertex source);
 
 private:
-	void recurSearch(UndirectedGraph& graph, shared_vertex source);
-	void examineBackEdgeIfFound(shared_vertex currentVertex, shared_vertex neighbor);
-
 	EdgeExaminer treeEdgeExaminer;
 	EdgeExaminer backEdgeExaminer;
 };
@@ -0,0 +1,275 @@
+#ifndef __GRAPH_ADAPTERS_H__
+#define __GRAPH_ADAPTERS_H__
+
+#include <cassert>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "graph.h"
+#include "adjacency_array.h"
+#include "disjoint_sets.h"
+#include "indexed_graph.h"
+
+/*
+ * Indexed graphs over storage owned by the caller. None of them copies the
+ * graph; the storage, or the functions describing the graph, must outlive the
+ * adapter and every traversal running over it.
+ */
+
+/*
+ * An indexed graph over adjacency arrays in compressed sparse row form: the
+ * neighbors of vertex v are `neighbors[offsets[v]]` to `neighbors[offsets[v + 1] - 1]`
+ */
+template <typename Index, typename Offset = std::size_t>
+class CsrGraphView {
+public:
+	using index_type = Index;
+
+	/*
+	 * @param vertexCount the number of vertices
+	 * @param offsets the vertexCount + 1 offsets of the neighbor lists
+	 * @param neighbors the concatenated neighbor lists
+	 */
+	CsrGraphView(std::size_t _vertexCount, const Offset* _offsets, const Index* _neighbors)
+		: count(_vertexCount), offsets(_offsets), neighbors(_neighbors) {}
+
+	std::size_t vertexCount() const { return count; }
+
+	BasicIndexRange<Index> neighborsOf(Index index) const
+	{
+		assert(static_cast<std::size_t>(index) < count);
+
+		return BasicIndexRange<Index>(neighbors + offsets[index], neighbors + offsets[index + 1]);
+	}
+
+private:
+	std::size_t count;
+	const Offset* offsets;
+	const Index* neighbors;
+};
+
+/*
+ * An indexed graph over an array of edges sorted by source, whose vertex IDs
+ * are the indices [0, vertexCount()). The neighbors of a vertex are found by
+ * binary search, in O(log E). An undirected graph must list every edge in both
+ * directions, so an array of edges in neither form is only zero-copy once it
+ * has been doubled and sorted; `hasCycle` below checks such an array in place.
+ */
+template <typename ID>
+class EdgeSpanGraph {
+public:
+	using index_type = typename std::make_unsigned<ID>::type;
+	using edge_type = BasicEdge<ID>;
+
+	class iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = index_type;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const index_type*;
+		using reference = index_type;
+
+		iterator() = default;
+		explicit iterator(const edge_type* _edge): edge(_edge) {}
+
+		index_type operator*() const { return static_cast<index_type>(edge->target); }
+
+		iterator& operator++()
+		{
+			++edge;
+			return *this;
+		}
+
+		iterator operator++(int)
+		{
+			auto previous = *this;
+			++edge;
+
+			return previous;
+		}
+
+		bool operator==(const iterator& other) const { return edge == other.edge; }
+		bool operator!=(const iterator& other) const { return edge != other.edge; }
+
+	private:
+		const edge_type* edge = nullptr;
+	};
+
+	class NeighborRange {
+	public:
+		NeighborRange(const edge_type* _first, const edge_type* _last): first(_first), last(_last) {}
+
+		iterator begin() const { return iterator(first); }
+		iterator end() const { return iterator(last); }
+
+		std::size_t size() const { return static_cast<std::size_t>(last - first); }
+		bool empty() const { return first == last; }
+
+	private:
+		const edge_type* first;
+		const edge_type* last;
+	};
+
+	/*
+	 * @param vertexCount the number of vertices
+	 * @param edges the edges, sorted by source
+	 * @param edgeCount the number of edges
+	 */
+	EdgeSpanGraph(std::size_t _vertexCount, const edge_type* _edges, std::size_t _edgeCount)
+		: count(_vertexCount), first(_edges), last(_edges + _edgeCount)
+	{
+		assert(std::is_sorted(first, last, [](const edge_type& a, const edge_type& b) { return a.source < b.source; }));
+	}
+
+	std::size_t vertexCount() const { return count; }
+
+	NeighborRange neighborsOf(index_type index) const
+	{
+		assert(static_cast<std::size_t>(index) < count);
+
+		auto source = static_cast<ID>(index);
+		auto lower = std::lower_bound(first, last, source, [](const edge_type& edge, ID id) { return edge.source < id; });
+		auto upper = std::upper_bound(lower, last, source, [](ID id, const edge_type& edge) { return id < edge.source; });
+
+		return NeighborRange(lower, upper);
+	}
+
+private:
+	std::size_t count;
+	const edge_type* first;
+	const edge_type* last;
+};
+
+/*
+ * Check if the undirected graph held in an array of edges contains a cycle, in
+ * place, with a union-find over the vertices. Unlike `EdgeSpanGraph`, the edges
+ * need not be sorted, and each is listed in one direction only. Self-loops are
+ * ignored, as in `UndirectedGraph`. As in `ExternalCycleDetector`, repeated
+ * edges cannot be told apart from cycles without remembering the edges, so the
+ * array is expected to hold each edge once.
+ *
+ * @param vertexCount one past the largest vertex ID in the edges
+ * @param edges the edges
+ * @param edgeCount the number of edges
+ * @return true if the graph contains a cycle, false otherwise
+ */
+template <typename ID>
+bool hasCycle(std::size_t vertexCount, const BasicEdge<ID>* edges, std::size_t edgeCount)
+{
+	using index_type = typename std::make_unsigned<ID>::type;
+
+	BasicDisjointSets<index_type> sets(vertexCount);
+
+	for (auto edge = edges; edge != edges + edgeCount; ++edge) {
+		if (edge->source != edge->target &&
+			!sets.unite(static_cast<index_type>(edge->source), static_cast<index_type>(edge->target)))
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * An indexed graph that is never stored, described instead by two functions:
+ * `degreeOf(v)` returns the number of neighbors of vertex v, and
+ * `neighborOf(v, k)` returns its k-th neighbor, for k in [0, degreeOf(v)).
+ */
+template <typename Index, typename DegreeFunction, typename NeighborFunction>
+class ImplicitGraph {
+public:
+	using index_type = Index;
+
+	class iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = Index;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const Index*;
+		using reference = Index;
+
+		iterator() = default;
+		iterator(const ImplicitGraph* _graph, Index _vertex, std::size_t _position)
+			: graph(_graph), vertex(_vertex), position(_position) {}
+
+		Index operator*() const { return static_cast<Index>(graph->neighborOf(vertex, position)); }
+
+		iterator& operator++()
+		{
+			++position;
+			return *this;
+		}
+
+		iterator operator++(int)
+		{
+			auto previous = *this;
+			++position;
+
+			return previous;
+		}
+
+		bool operator==(const iterator& other) const { return position == other.position && vertex == other.vertex; }
+		bool operator!=(const iterator& other) const { return !(*this == other); }
+
+	private:
+		const ImplicitGraph* graph = nullptr;
+		Index vertex = 0;
+		std::size_t position = 0;
+	};
+
+	class NeighborRange {
+	public:
+		NeighborRange(const ImplicitGraph* _graph, Index _vertex, std::size_t _degree)
+			: graph(_graph), vertex(_vertex), degree(_degree) {}
+
+		iterator begin() const { return iterator(graph, vertex, 0); }
+		iterator end() const { return iterator(graph, vertex, degree); }
+
+		std::size_t size() const { return degree; }
+		bool empty() const { return 0 == degree; }
+
+	private:
+		const ImplicitGraph* graph;
+		Index vertex;
+		std::size_t degree;
+	};
+
+	/*
+	 * @param vertexCount the number of vertices
+	 * @param degreeOf the function returning the degree of a vertex
+	 * @param neighborOf the function returning a neighbor of a vertex by position
+	 */
+	ImplicitGraph(std::size_t _vertexCount, DegreeFunction _degreeOf, NeighborFunction _neighborOf)
+		: count(_vertexCount), degreeOf(_degreeOf), neighborOf(_neighborOf) {}
+
+	std::size_t vertexCount() const { return count; }
+
+	NeighborRange neighborsOf(Index index) const
+	{
+		assert(static_cast<std::size_t>(index) < count);
+
+		return NeighborRange(this, index, static_cast<std::size_t>(degreeOf(index)));
+	}
+
+private:
+	std::size_t count;
+	DegreeFunction degreeOf;
+	NeighborFunction neighborOf;
+};
+
+/*
+ * Make an implicit graph, deducing the types of its functions
+ *
+ * @param vertexCount the number of vertices
+ * @param degreeOf the function returning the degree of a vertex
+ * @param neighborOf the function returning a neighbor of a vertex by position
+ */
+template <typename Index, typename DegreeFunction, typename NeighborFunction>
+ImplicitGraph<Index, DegreeFunction, NeighborFunction> makeImplicitGraph(std::size_t vertexCount,
+	                                                                     DegreeFunction degreeOf, NeighborFunction neighborOf)
+{
+	return ImplicitGraph<Index, DegreeFunction, NeighborFunction>(vertexCount, degreeOf, neighborOf);
+}
+
+#endif
@@ -0,0 +1,345 @@
+#ifndef __GRAPH_ANALYSIS_H__
+#define __GRAPH_ANALYSIS_H__
+
+#include <cassert>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "graph.h"
+#include "compact_graph.h"
+
+/*
+ * An analysis that follows a depth-first search of an undirected graph over
+ * dense indices. A pass keeps only the state of its own analysis; the search
+ * itself, with its discovery states and stack, is shared by every pass
+ * registered on a `FusedTraversal`.
+ */
+template <typename Index>
+class AnalysisPass {
+public:
+	virtual ~AnalysisPass() = default;
+
+	/*
+	 * Called once before the search starts
+	 *
+	 * @param vertexCount the number of vertices in the graph
+	 */
+	virtual void start(std::size_t vertexCount) {}
+
+	/*
+	 * Called when the search enters a new component, before its root is discovered
+	 */
+	virtual void startComponent(Index root) {}
+
+	/*
+	 * Called when a vertex is discovered, before the tree edge that leads to it
+	 * is examined
+	 *
+	 * @param vertex the index of the vertex
+	 * @param degree the number of neighbors of the vertex
+	 */
+	virtual void discoverVertex(Index vertex, std::size_t degree) {}
+
+	/*
+	 * Called for every tree edge, and for every back edge from the side of the
+	 * descendant
+	 */
+	virtual void examineEdge(EdgeKind kind, Index source, Index target) {}
+
+	/*
+	 * Called when every neighbor of a vertex has been examined
+	 *
+	 * @param vertex the index of the vertex
+	 * @param parent the index of its parent in the search tree, or the maximum
+	 *        value of the index type for a root
+	 */
+	virtual void finishVertex(Index vertex, Index parent) {}
+
+	/*
+	 * Called once after the search has visited every component
+	 */
+	virtual void finish() {}
+};
+
+/*
+ * A depth-first search of every component of an undirected graph that drives
+ * several analyses at once. The search is a `CompactDepthFirstTraversal`, so the
+ * adjacency and the search state are swept only once however many passes are
+ * registered, and running another analysis costs little more than the state
+ * that it keeps.
+ */
+template <typename Graph>
+class FusedTraversal {
+public:
+	using index_type = typename Graph::index_type;
+	using pass_type = AnalysisPass<index_type>;
+
+	static constexpr index_type noParent = CompactDepthFirstTraversal<Graph>::noParent;
+
+	/*
+	 * @param graph the graph to search, which must outlive the traversal
+	 */
+	explicit FusedTraversal(const Graph& _graph): graph(_graph) {}
+
+	/*
+	 * Register a pass to be driven by the search. Passes are notified in the
+	 * order in which they were registered.
+	 *
+	 * @param pass the pass to register, which must outlive the traversal
+	 */
+	void registerPass(pass_type& pass) { passes.push_back(&pass); }
+
+	/*
+	 * Search the whole graph once, notifying every registered pass
+	 */
+	void run();
+
+private:
+	/*
+	 * Forwards the vertex events of the search to every pass
+	 */
+	struct PassNotifier {
+		void startComponent(index_type root)
+		{
+			for (auto pass : passes)
+				pass->startComponent(root);
+		}
+
+		void discoverVertex(index_type vertex, std::size_t degree)
+		{
+			for (auto pass : passes)
+				pass->discoverVertex(vertex, degree);
+		}
+
+		void finishVertex(index_type vertex, index_type parent)
+		{
+			for (auto pass : passes)
+				pass->finishVertex(vertex, parent);
+		}
+
+		const std::vector<pass_type*>& passes;
+	};
+
+	const Graph& graph;
+	std::vector<pass_type*> passes;
+};
+
+template <typename Index>
+class CycleDetectionPass : public AnalysisPass<Index> {
+public:
+	bool hasCycle() const { return bHasCycle; }
+
+	void start(std::size_t vertexCount) override { bHasCycle = false; }
+	void examineEdge(EdgeKind kind, Index source, Index target) override
+	{
+		if (EdgeKind::Back == kind)
+			bHasCycle = true;
+	}
+
+private:
+	bool bHasCycle = false;
+};
+
+template <typename Index>
+class ConnectedComponentsPass : public AnalysisPass<Index> {
+public:
+	std::size_t componentCount() const { return count; }
+
+	/*
+	 * @return the number of the component containing the vertex, in the order in
+	 *         which the components were searched
+	 */
+	std::size_t componentOf(Index vertex) const { return components[vertex]; }
+
+	void start(std::size_t vertexCount) override
+	{
+		count = 0;
+		components.assign(vertexCount, 0);
+	}
+
+	void startComponent(Index root) override { ++count; }
+	void discoverVertex(Index vertex, std::size_t degree) override
+	{
+		components[vertex] = static_cast<Index>(count - 1);
+	}
+
+private:
+	std::size_t count = 0;
+	std::vector<Index> components;
+};
+
+/*
+ * A graph is bipartite if its vertices can be coloured with two colours so that
+ * no edge joins two vertices of the same colour. Tree edges alternate colours,
+ * so it suffices to check the back edges.
+ */
+template <typename Index>
+class BipartitenessPass : public AnalysisPass<Index> {
+public:
+	bool isBipartite() const { return bBipartite; }
+
+	/*
+	 * @return the side of the vertex in a two-colouring, if the graph is bipartite
+	 */
+	bool sideOf(Index vertex) const { return sides[vertex]; }
+
+	void start(std::size_t vertexCount) override
+	{
+		bBipartite = true;
+		sides.assign(vertexCount, false);
+	}
+
+	void examineEdge(EdgeKind kind, Index source, Index target) override
+	{
+		if (EdgeKind::Tree == kind)
+			sides[target] = !sides[source];
+		else if (sides[source] == sides[target])
+			bBipartite = false;
+	}
+
+private:
+	bool bBipartite = true;
+	std::vector<bool> sides;
+};
+
+template <typename Index>
+class DegreeStatisticsPass : public AnalysisPass<Index> {
+public:
+	std::size_t minimumDegree() const { return minimum; }
+	std::size_t maximumDegree() const { return maximum; }
+	double averageDegree() const { return vertexCount > 0 ? static_cast<double>(degreeSum) / vertexCount : 0.0; }
+
+	void start(std::size_t _vertexCount) override
+	{
+		vertexCount = _vertexCount;
+		degreeSum = 0;
+		minimum = vertexCount > 0 ? std::numeric_limits<std::size_t>::max() : 0;
+		maximum = 0;
+	}
+
+	void discoverVertex(Index vertex, std::size_t degree) override
+	{
+		degreeSum += degree;
+		minimum = std::min(minimum, degree);
+		maximum = std::max(maximum, degree);
+	}
+
+private:
+	std::size_t vertexCount = 0;
+	std::size_t degreeSum = 0;
+	std::size_t minimum = 0;
+	std::size_t maximum = 0;
+};
+
+/*
+ * An articulation point is a vertex whose removal disconnects its component.
+ * They are found with Hopcroft and Tarjan's low-link values: a vertex other
+ * than a root is one if some child subtree has no back edge above it, and a
+ * root is one if it has more than one child.
+ */
+template <typename Index>
+class ArticulationPointsPass : public AnalysisPass<Index> {
+public:
+	bool isArticulationPoint(Index vertex) const { return articulations[vertex]; }
+
+	/*
+	 * @return the articulation points in increasing order of index
+	 */
+	std::vector<Index> articulationPoints() const;
+
+	void start(std::size_t vertexCount) override
+	{
+		time = 0;
+		discoveryTimes.assign(vertexCount, 0);
+		lowLinks.assign(vertexCount, 0);
+		articulations.assign(vertexCount, false);
+	}
+
+	void startComponent(Index _root) override
+	{
+		root = _root;
+		rootChildren = 0;
+	}
+
+	void discoverVertex(Index vertex, std::size_t degree) override
+	{
+		discoveryTimes[vertex] = lowLinks[vertex] = time++;
+	}
+
+	void examineEdge(EdgeKind kind, Index source, Index target) override
+	{
+		if (EdgeKind::Tree == kind) {
+			if (root == source)
+				++rootChildren;
+		}
+		else {
+			lowLinks[source] = std::min(lowLinks[source], discoveryTimes[target]);
+		}
+	}
+
+	void finishVertex(Index vertex, Index parent) override;
+
+private:
+	Index time = 0;
+	Index root = 0;
+	std::size_t rootChildren = 0;
+	std::vector<Index> discoveryTimes;
+	std::vector<Index> lowLinks;
+	std::vector<bool> articulations;
+};
+
+
+template <typename Graph>
+constexpr typename Graph::index_type FusedTraversal<Graph>::noParent;
+
+template <typename Graph>
+void FusedTraversal<Graph>::run()
+{
+	CompactDepthFirstTraversal<Graph> traversal(graph);
+	PassNotifier notifier{ passes };
+	typename CompactDepthFirstTraversal<Graph>::event_type event;
+
+	for (auto pass : passes)
+		pass->start(graph.vertexCount());
+
+	while (traversal.next(event, notifier)) {
+		for (auto pass : passes)
+			pass->examineEdge(event.kind, event.source, event.target);
+	}
+
+	for (auto pass : passes)
+		pass->finish();
+}
+
+template <typename Index>
+std::vector<Index> ArticulationPointsPass<Index>::articulationPoints() const
+{
+	std::vector<Index> points;
+
+	for (std::size_t vertex = 0; vertex < articulations.size(); ++vertex) {
+		if (articulations[vertex])
+			points.push_back(static_cast<Index>(vertex));
+	}
+
+	return points;
+}
+
+template <typename Index>
+void ArticulationPointsPass<Index>::finishVertex(Index vertex, Index parent)
+{
+	if (std::numeric_limits<Index>::max() == parent) {
+		if (rootChildren > 1)
+			articulations[vertex] = true;
+		return;
+	}
+
+	lowLinks[parent] = std::min(lowLinks[parent], lowLinks[vertex]);
+
+	if (parent != root && lowLinks[vertex] >= discoveryTimes[parent])
+		articulations[parent] = true;
+}
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef __INDEXED_GRAPH_H__
+#define __INDEXED_GRAPH_H__
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/*
+ * The requirements that the traversal and cycle engines place on a graph over
+ * dense vertex indices. A type `Graph` models an indexed graph if, for a
+ * `const Graph& graph` and an `index` of type `Graph::index_type`:
+ *
+ *   - `graph.vertexCount()` is the number of vertices, whose indices are
+ *     [0, vertexCount());
+ *   - `graph.neighborsOf(index)` is a range of indices with `begin()`, `end()`
+ *     and `size()`. Its iterators must stay valid after the range itself is
+ *     destroyed, for as long as the graph lives.
+ *
+ * Undirected graphs list every edge from both of its endpoints, with no
+ * self-loops and no repeated neighbors, as `UndirectedGraph` would hold them.
+ * The undirected engines still agree on a graph that breaks this: they skip
+ * self-loops, and take a repeated neighbor as a single edge, so that neither
+ * makes a cycle on its own. Degrees are still taken as `size()`.
+ *
+ * The compact graphs, `GraphVersion` and the adapters in `graph_adapters.h`
+ * all model it.
+ */
+template <typename...>
+struct MakeVoid {
+	using type = void;
+};
+
+template <typename Graph>
+using NeighborRange = decltype(std::declval<const Graph&>().neighborsOf(std::declval<typename Graph::index_type>()));
+
+template <typename Graph>
+using NeighborIterator = decltype(std::declval<NeighborRange<Graph>>().begin());
+
+template <typename Graph, typename = void>
+struct IsIndexedGraph : std::false_type {};
+
+template <typename Graph>
+struct IsIndexedGraph<Graph, typename MakeVoid<
+	decltype(std::declval<const Graph&>().vertexCount()),
+	NeighborIterator<Graph>,
+	decltype(std::declval<NeighborRange<Graph>>().size())>::type> : std::true_type {};
+
+#endif
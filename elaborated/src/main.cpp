@@ -1,24 +1,34 @@
+#include <csignal>
 #include <iostream>
 #include <vector>
 #include <queue>
+#include <string>
+#include <thread>
+#include <utility>
 #include "graph.h"
+#include "compact_graph.h"
+#include "external_cycle_detector.h"
+#include "query_server.h"
+#include "small_graph.h"
 
 
 using namespace std;
 
-bool has_cycle(const vector<Edge>& edges) {
-    DepthFirstVisitor depthFirst;
-    bool foundBackEdge = false;
-    depthFirst.registerBackEdgeExaminer([&foundBackEdge](const shared_vertex source,
-                                      const shared_vertex target)
-                                      { foundBackEdge = true; });
+constexpr Edge edges_with_cycle[] = { {0, 1}, {0, 2}, {0, 3}, {1, 4}, {1, 5}, {4, 8}, {4, 9}, {3, 6}, {3, 7}, {6, 10}, {6, 11}, {5, 9} };
+constexpr Edge edges_without_cycle[] = { {0, 1}, {0, 2}, {0, 3}, {1, 4}, {1, 5}, {4, 8}, {4, 9}, {3, 6}, {3, 7}, {6, 10}, {6, 11} };
+
+static_assert(hasCycle(SmallUndirectedGraph(edges_with_cycle)), "the first topology must contain a cycle");
+static_assert(!hasCycle(SmallUndirectedGraph(edges_without_cycle)), "the second topology must not contain a cycle");
 
-    UndirectedGraph graph(edges);
-    auto source = graph.getVertexById(0);
+bool has_cycle(const vector<Edge>& edges) {
+    // Graphs of at most 64 vertices are checked with bit operations on the stack.
+    SmallUndirectedGraph small_graph(edges.data(), edges.data() + edges.size());
+    if (small_graph.fits())
+        return hasCycle(small_graph);
 
-    depthFirst.search(graph, source);
+    CompactUndirectedGraph graph(edges);
 
-    return foundBackEdge;
+    return hasCycle(graph);
 }
 
 
@@ -36,12 +46,87 @@ void check_for_cycles(const vector<Edge>& edges) {
 }
 
 
+QueryServer* listening_server = nullptr;
+
+void stop_listening(int) {
+    if (listening_server)
+        listening_server->stop();
+}
+
+
+// elaborated --serve [--socket <path>] [--threads <count>] <name>=<edge-file>...
+int run_server(int argc, const char* argv[]) {
+    string socket_path;
+    unsigned thread_count = thread::hardware_concurrency();
+    vector<pair<string, string>> graph_files;
+
+    try {
+        for (int i = 2; i < argc; ++i) {
+            string argument = argv[i];
+
+            if ("--socket" == argument && i + 1 < argc) {
+                socket_path = argv[++i];
+            } else if ("--threads" == argument && i + 1 < argc) {
+                thread_count = static_cast<unsigned>(stoul(argv[++i]));
+            } else if (argument.find('=') != string::npos) {
+                auto separator = argument.find('=');
+                graph_files.push_back({ argument.substr(0, separator), argument.substr(separator + 1) });
+            } else {
+                cerr << "unexpected argument " << argument << "\n";
+                return 1;
+            }
+        }
+
+        QueryServer server(thread_count);
+        for (auto&& graph_file : graph_files)
+            server.load(graph_file.first, readEdgeFile(graph_file.second));
+
+        if (socket_path.empty()) {
+            server.serve(cin, cout);
+        } else {
+            // Interrupting the server lets it unlink the socket and report its latency.
+            listening_server = &server;
+            signal(SIGINT, stop_listening);
+            signal(SIGTERM, stop_listening);
+            server.listen(socket_path);
+            listening_server = nullptr;
+        }
+
+        auto latency = server.latency();
+        cerr << latency.count << " queries, p50 " << latency.p50Microseconds
+             << " us, p99 " << latency.p99Microseconds << " us\n";
+    } catch (const exception& e) {
+        listening_server = nullptr;
+        cerr << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
+
+
 int main(int argc, const char* argv[]) {
-    const vector<Edge> edges_with_cycle = { {0, 1}, {0, 2}, {0, 3}, {1, 4}, {1, 5}, {4, 8}, {4, 9}, {3, 6}, {3, 7}, {6, 10}, {6, 11}, {5, 9} };
-    const vector<Edge> edges_without_cycle = { {0, 1}, {0, 2}, {0, 3}, {1, 4}, {1, 5}, {4, 8}, {4, 9}, {3, 6}, {3, 7}, {6, 10}, {6, 11} };
+    if (argc > 1 && string("--serve") == argv[1])
+        return run_server(argc, argv);
+
+    if (argc > 1) {
+        // Check an edge file from disk without loading it into memory. Knowing the
+        // vertex count up front saves the pass that would otherwise find it.
+        ExternalCycleDetector detector;
+        try {
+            if (argc > 2)
+                report_results(detector.hasCycle(argv[1], stoull(argv[2])));
+            else
+                report_results(detector.hasCycle(argv[1]));
+        } catch (const exception& e) {
+            cerr << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
 
-    check_for_cycles(edges_with_cycle);
-    check_for_cycles(edges_without_cycle);
+    check_for_cycles(vector<Edge>(begin(edges_with_cycle), end(edges_with_cycle)));
+    check_for_cycles(vector<Edge>(begin(edges_without_cycle), end(edges_without_cycle)));
 
     return 0;
 }
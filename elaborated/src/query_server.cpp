@@ -0,0 +1,399 @@
+#include "query_server.h"
+#include <cassert>
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "disjoint_sets.h"
+#include "worker_pool.h"
+
+namespace {
+
+const char* yesOrNo(bool answer)
+{
+	return answer ? "yes" : "no";
+}
+
+bool writeAll(int connection, const std::string& data)
+{
+	std::size_t written = 0;
+
+	while (written < data.size()) {
+		auto count = ::send(connection, data.data() + written, data.size() - written, MSG_NOSIGNAL);
+		if (count < 0 && EINTR == errno)
+			continue;
+		if (count <= 0)
+			return false;
+
+		written += static_cast<std::size_t>(count);
+	}
+
+	return true;
+}
+
+/*
+ * Collects responses that complete out of order and releases them in the order
+ * of their queries
+ */
+class ResponseSequencer {
+public:
+	/*
+	 * @param sequence the position of the query among the queries of its stream
+	 * @param response the response to the query
+	 * @param write called, under a lock, with every response that can now be
+	 *        written, in order
+	 */
+	template <typename Write>
+	void complete(std::size_t sequence, std::string response, Write write)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pending[sequence] = std::move(response);
+
+		for (auto it = pending.find(nextToWrite); it != pending.end(); it = pending.find(nextToWrite)) {
+			write(it->second);
+			pending.erase(it);
+			++nextToWrite;
+		}
+	}
+
+private:
+	std::mutex mutex;
+	std::map<std::size_t, std::string> pending;
+	std::size_t nextToWrite = 0;
+};
+
+}
+
+/*
+ * The state of one socket connection. It is shared by the polling thread and the
+ * tasks answering its queries, and the socket is closed when the last of them
+ * lets go, so that every query read is answered.
+ */
+struct QueryServer::Connection {
+	explicit Connection(int _socket): socket(_socket) {}
+	~Connection() { ::close(socket); }
+
+	void write(std::size_t sequence, std::string response)
+	{
+		responses.complete(sequence, std::move(response), [this](const std::string& line) {
+			if (!bBroken && !writeAll(socket, line))
+				bBroken = true;
+		});
+	}
+
+	int socket;
+	std::string received;
+	std::size_t submitted = 0;
+	ResponseSequencer responses;
+	bool bBroken = false;
+};
+
+ResidentGraph::ResidentGraph(const std::vector<Edge>& edges)
+	: graph(edges), components(graph.vertexCount()), componentSizes(graph.vertexCount(), 0)
+{
+	DisjointSets sets(graph.vertexCount());
+
+	for (VertexIndex vertex = 0; vertex < graph.vertexCount(); ++vertex) {
+		for (VertexIndex neighbor : graph.neighborsOf(vertex)) {
+			if (vertex < neighbor && !sets.unite(vertex, neighbor))
+				bHasCycle = true;
+		}
+	}
+
+	for (VertexIndex vertex = 0; vertex < graph.vertexCount(); ++vertex) {
+		components[vertex] = sets.find(vertex);
+		++componentSizes[components[vertex]];
+	}
+}
+
+bool ResidentGraph::isReachable(VertexID source, VertexID target) const
+{
+	return components[graph.indexOf(source)] == components[graph.indexOf(target)];
+}
+
+VertexID ResidentGraph::componentOf(VertexID id) const
+{
+	return graph.idOf(components[graph.indexOf(id)]);
+}
+
+std::size_t ResidentGraph::componentSize(VertexID id) const
+{
+	return componentSizes[components[graph.indexOf(id)]];
+}
+
+LatencyRecorder::LatencyRecorder(std::size_t _capacity)
+	: capacity(_capacity)
+{
+	assert(capacity > 0);
+
+	samples.reserve(capacity);
+}
+
+void LatencyRecorder::record(std::chrono::nanoseconds latency)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (samples.size() < capacity)
+		samples.push_back(latency.count());
+	else
+		samples[count % capacity] = latency.count();
+
+	++count;
+}
+
+LatencyRecorder::Summary LatencyRecorder::summarize() const
+{
+	std::vector<std::int64_t> sorted;
+	Summary summary = { 0, 0.0, 0.0 };
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		sorted = samples;
+		summary.count = count;
+	}
+
+	if (sorted.empty())
+		return summary;
+
+	std::sort(sorted.begin(), sorted.end());
+	auto percentile = [&sorted](double fraction) {
+		auto rank = static_cast<std::size_t>(fraction * (sorted.size() - 1) + 0.5);
+		return sorted[rank] / 1000.0;
+	};
+
+	summary.p50Microseconds = percentile(0.50);
+	summary.p99Microseconds = percentile(0.99);
+
+	return summary;
+}
+
+const std::size_t QueryServer::maxQueryLength;
+
+QueryServer::QueryServer(unsigned _threadCount)
+	: threadCount(std::max(1u, _threadCount)), bStopping(false)
+{
+	if (::pipe(wakeup) < 0)
+		throw std::runtime_error("failed to create wakeup pipe");
+
+	::fcntl(wakeup[0], F_SETFL, O_NONBLOCK);
+	::fcntl(wakeup[1], F_SETFL, O_NONBLOCK);
+}
+
+QueryServer::~QueryServer()
+{
+	::close(wakeup[0]);
+	::close(wakeup[1]);
+}
+
+void QueryServer::load(const std::string& name, const std::vector<Edge>& edges)
+{
+	graphs[name].reset(new ResidentGraph(edges));
+}
+
+std::string QueryServer::answer(const std::string& query, std::chrono::steady_clock::time_point received)
+{
+	auto response = respond(query);
+	latencies.record(std::chrono::steady_clock::now() - received);
+
+	return response;
+}
+
+std::string QueryServer::respond(const std::string& query) const
+{
+	std::istringstream words(query);
+	std::string command;
+	std::string graphName;
+	words >> command;
+
+	if ("stats" == command) {
+		auto summary = latencies.summarize();
+		std::ostringstream response;
+		response << "queries " << summary.count << " p50_us " << summary.p50Microseconds
+			     << " p99_us " << summary.p99Microseconds;
+		return response.str();
+	}
+
+	if ("cycle" != command && "reach" != command && "component" != command)
+		return "error unknown command";
+
+	if (!(words >> graphName))
+		return "error missing graph name";
+
+	auto found = graphs.find(graphName);
+	if (found == graphs.end())
+		return "error unknown graph " + graphName;
+
+	auto& graph = *found->second;
+
+	if ("cycle" == command)
+		return yesOrNo(graph.hasCycle());
+
+	std::vector<VertexID> vertices("reach" == command ? 2 : 1);
+	for (auto& vertex : vertices) {
+		if (!(words >> vertex))
+			return "error missing vertex ID";
+		if (!graph.hasVertex(vertex))
+			return "error unknown vertex " + std::to_string(vertex);
+	}
+
+	if ("reach" == command)
+		return yesOrNo(graph.isReachable(vertices[0], vertices[1]));
+
+	return "component " + std::to_string(graph.componentOf(vertices[0])) + " " +
+		   std::to_string(graph.componentSize(vertices[0]));
+}
+
+void QueryServer::serve(std::istream& input, std::ostream& output)
+{
+	ResponseSequencer responses;
+	std::size_t submitted = 0;
+
+	WorkerPool pool(threadCount);
+	std::string query;
+
+	while (std::getline(input, query)) {
+		auto received = std::chrono::steady_clock::now();
+		auto sequence = submitted++;
+
+		pool.submit([this, query, received, sequence, &responses, &output]() {
+			responses.complete(sequence, answer(query, received), [&output](const std::string& line) {
+				output << line << '\n';
+				output.flush();
+			});
+		});
+	}
+}
+
+void QueryServer::listen(const std::string& socketPath)
+{
+	sockaddr_un address;
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+
+	if (socketPath.size() >= sizeof(address.sun_path))
+		throw std::invalid_argument("socket path is too long: " + socketPath);
+	std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+	// A socket left behind by an earlier server is replaced, but nothing else is.
+	struct stat existing;
+	if (::lstat(socketPath.c_str(), &existing) == 0) {
+		if (!S_ISSOCK(existing.st_mode))
+			throw std::runtime_error("socket path exists and is not a socket: " + socketPath);
+		::unlink(socketPath.c_str());
+	}
+
+	int socketFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (socketFd < 0)
+		throw std::runtime_error("failed to create socket");
+
+	if (::bind(socketFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+		::listen(socketFd, SOMAXCONN) < 0) {
+		::close(socketFd);
+		throw std::runtime_error("failed to listen on " + socketPath);
+	}
+
+	{
+		WorkerPool pool(threadCount);
+		std::vector<std::shared_ptr<Connection>> connections;
+		std::vector<pollfd> polled;
+
+		while (!bStopping) {
+			polled.assign({ { wakeup[0], POLLIN, 0 }, { socketFd, POLLIN, 0 } });
+			for (auto&& connection : connections)
+				polled.push_back({ connection->socket, POLLIN, 0 });
+
+			if (::poll(polled.data(), polled.size(), -1) < 0) {
+				if (EINTR == errno)
+					continue;
+				break;
+			}
+
+			if (polled[0].revents != 0)
+				break;
+
+			for (std::size_t i = connections.size(); i-- > 0;) {
+				if (polled[i + 2].revents != 0 && !readQueries(pool, connections[i]))
+					connections.erase(connections.begin() + i);
+			}
+
+			if (polled[1].revents & POLLIN) {
+				int connection = ::accept(socketFd, nullptr, nullptr);
+				if (connection >= 0) {
+					// A client that stops reading must not hold a worker for long.
+					timeval sendTimeout = { 5, 0 };
+					::setsockopt(connection, SOL_SOCKET, SO_SNDTIMEO, &sendTimeout, sizeof(sendTimeout));
+					connections.push_back(std::make_shared<Connection>(connection));
+				}
+			}
+		}
+	}
+
+	::close(socketFd);
+	::unlink(socketPath.c_str());
+
+	// Consume the stop request, so that the server can listen again.
+	char signal;
+	while (::read(wakeup[0], &signal, 1) > 0 || EINTR == errno)
+		;
+	bStopping = false;
+}
+
+void QueryServer::stop()
+{
+	bStopping = true;
+
+	char signal = 0;
+	while (::write(wakeup[1], &signal, 1) < 0 && EINTR == errno)
+		;
+}
+
+bool QueryServer::readQueries(WorkerPool& pool, const std::shared_ptr<Connection>& connection)
+{
+	char chunk[4096];
+	auto count = ::read(connection->socket, chunk, sizeof(chunk));
+	if (count < 0 && EINTR == errno)
+		return true;
+	if (count <= 0)
+		return false;
+
+	auto received = std::chrono::steady_clock::now();
+	auto& buffer = connection->received;
+	buffer.append(chunk, static_cast<std::size_t>(count));
+
+	std::size_t lineStart = 0;
+	std::size_t lineEnd;
+	while ((lineEnd = buffer.find('\n', lineStart)) != std::string::npos) {
+		auto query = buffer.substr(lineStart, lineEnd - lineStart);
+		lineStart = lineEnd + 1;
+
+		if (!query.empty() && '\r' == query.back())
+			query.pop_back();
+
+		if ("quit" == query)
+			return false;
+
+		auto sequence = connection->submitted++;
+		pool.submit([this, connection, query, received, sequence]() {
+			connection->write(sequence, answer(query, received) + "\n");
+		});
+	}
+	buffer.erase(0, lineStart);
+
+	if (buffer.size() > maxQueryLength) {
+		connection->write(connection->submitted++, "error query too long\n");
+		return false;
+	}
+
+	return true;
+}
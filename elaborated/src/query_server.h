@@ -0,0 +1,184 @@
+#ifndef __QUERY_SERVER_H__
+#define __QUERY_SERVER_H__
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "graph.h"
+#include "compact_graph.h"
+
+class WorkerPool;
+
+/*
+ * An undirected graph kept in memory between queries, along with the answers
+ * that every query needs: whether it contains a cycle, and which component
+ * each vertex belongs to. It is never modified after construction, so any
+ * number of threads may query it at once.
+ */
+class ResidentGraph {
+public:
+	explicit ResidentGraph(const std::vector<Edge>& edges);
+
+	bool hasCycle() const { return bHasCycle; }
+	bool hasVertex(VertexID id) const { return graph.hasVertex(id); }
+
+	/*
+	 * Check if there is a path between two vertices of the graph
+	 *
+	 * @param source the ID of a vertex present in the graph
+	 * @param target the ID of a vertex present in the graph
+	 * @return true if both vertices are in the same component, false otherwise
+	 */
+	bool isReachable(VertexID source, VertexID target) const;
+
+	/*
+	 * @param id the ID of a vertex present in the graph
+	 * @return the ID of the vertex representing the component of the given vertex
+	 */
+	VertexID componentOf(VertexID id) const;
+
+	/*
+	 * @param id the ID of a vertex present in the graph
+	 * @return the number of vertices in the component of the given vertex
+	 */
+	std::size_t componentSize(VertexID id) const;
+
+private:
+	CompactUndirectedGraph graph;
+	bool bHasCycle = false;
+	std::vector<VertexIndex> components;
+	std::vector<VertexIndex> componentSizes;
+};
+
+/*
+ * Keeps the most recent latency samples and summarizes them on demand
+ */
+class LatencyRecorder {
+public:
+	struct Summary {
+		std::size_t count;
+		double p50Microseconds;
+		double p99Microseconds;
+	};
+
+	explicit LatencyRecorder(std::size_t capacity = 1 << 16);
+
+	void record(std::chrono::nanoseconds latency);
+
+	/*
+	 * @return the number of samples recorded so far, and the percentiles of
+	 *         the most recent ones
+	 */
+	Summary summarize() const;
+
+private:
+	mutable std::mutex mutex;
+	std::vector<std::int64_t> samples;
+	std::size_t capacity;
+	std::size_t count = 0;
+};
+
+/*
+ * Answers queries about named graphs that are loaded once and then stay
+ * resident. Queries are lines of text:
+ *
+ *   cycle <graph>              "yes" or "no"
+ *   reach <graph> <u> <v>      "yes" or "no"
+ *   component <graph> <v>      "component <representative> <size>"
+ *   stats                      "queries <count> p50_us <p50> p99_us <p99>"
+ *
+ * Malformed queries are answered with "error <reason>".
+ */
+class QueryServer {
+public:
+	/*
+	 * @param threadCount the number of worker threads answering queries
+	 */
+	explicit QueryServer(unsigned threadCount = std::thread::hardware_concurrency());
+	~QueryServer();
+
+	QueryServer(const QueryServer&) = delete;
+	QueryServer& operator=(const QueryServer&) = delete;
+
+	/*
+	 * Build a graph and keep it resident under the given name. All graphs must be
+	 * loaded before the server starts serving.
+	 *
+	 * @param name the name queries refer to the graph by
+	 * @param edges the edges of the graph
+	 */
+	void load(const std::string& name, const std::vector<Edge>& edges);
+
+	/*
+	 * Answer a single query. This may be called from several threads at once.
+	 *
+	 * @param query one line of the protocol
+	 * @return the response line, without a line terminator
+	 */
+	std::string answer(const std::string& query) { return answer(query, std::chrono::steady_clock::now()); }
+
+	/*
+	 * Answer queries read line by line from the input until it ends. Queries are
+	 * answered concurrently by the worker pool, and responses are written in the
+	 * order of the queries.
+	 */
+	void serve(std::istream& input, std::ostream& output);
+
+	/*
+	 * Accept connections on a Unix domain socket until `stop()` is called. A single
+	 * thread polls every connection, and each query is answered by the worker pool
+	 * as soon as its line arrives, so an idle connection holds no worker. Responses
+	 * are written in the order of the queries of their connection. Sending "quit"
+	 * closes the connection, and so does a line longer than `maxQueryLength`.
+	 *
+	 * A socket already at the path, e.g. left by a server that was killed, is
+	 * replaced; any other file there makes `listen()` throw instead.
+	 *
+	 * @param socketPath the filesystem path to bind the socket to
+	 */
+	void listen(const std::string& socketPath);
+
+	/*
+	 * Make `listen()` stop accepting connections and reading queries, answer the
+	 * queries already read and return. If no `listen()` is running, the next one
+	 * returns at once. Once it has returned, the server may listen again. This is
+	 * safe to call from a signal handler.
+	 */
+	void stop();
+
+	LatencyRecorder::Summary latency() const { return latencies.summarize(); }
+
+	static const std::size_t maxQueryLength = 4096;
+
+private:
+	struct Connection;
+
+	/*
+	 * Answer a query, recording its latency from the time it was received
+	 */
+	std::string answer(const std::string& query, std::chrono::steady_clock::time_point received);
+	std::string respond(const std::string& query) const;
+
+	/*
+	 * Read the data available on a connection and submit the complete queries
+	 *
+	 * @return false once no more queries will be read from the connection
+	 */
+	bool readQueries(WorkerPool& pool, const std::shared_ptr<Connection>& connection);
+
+	unsigned threadCount;
+	std::map<std::string, std::unique_ptr<const ResidentGraph>> graphs;
+	LatencyRecorder latencies;
+	std::atomic<bool> bStopping;
+	int wakeup[2];
+};
+
+#endif
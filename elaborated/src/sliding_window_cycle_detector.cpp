@@ -0,0 +1,360 @@
+#include "sliding_window_cycle_detector.h"
+#include <cassert>
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace {
+
+const LinkCutForest::Weight vertexWeight = std::numeric_limits<LinkCutForest::Weight>::max();
+
+}
+
+const LinkCutForest::Node LinkCutForest::noNode;
+
+LinkCutForest::Node LinkCutForest::makeNode(Weight weight)
+{
+	Node node;
+
+	if (released.empty()) {
+		node = static_cast<Node>(nodes.size());
+		nodes.emplace_back();
+	}
+	else {
+		node = released.back();
+		released.pop_back();
+	}
+
+	nodes[node] = { { noNode, noNode }, noNode, node, weight, false };
+
+	return node;
+}
+
+void LinkCutForest::releaseNode(Node node)
+{
+	released.push_back(node);
+}
+
+void LinkCutForest::setWeight(Node node, Weight weight)
+{
+	access(node);
+	splay(node);
+
+	nodes[node].weight = weight;
+	pullUp(node);
+}
+
+bool LinkCutForest::isConnected(Node u, Node v)
+{
+	return findRoot(u) == findRoot(v);
+}
+
+void LinkCutForest::link(Node u, Node v)
+{
+	assert(!isConnected(u, v));
+
+	makeRoot(u);
+	nodes[u].parent = v;
+}
+
+void LinkCutForest::cut(Node u, Node v)
+{
+	makeRoot(u);
+	access(v);
+	splay(v);
+
+	assert(nodes[v].child[0] == u && nodes[u].child[1] == noNode);
+
+	nodes[v].child[0] = noNode;
+	nodes[u].parent = noNode;
+	pullUp(v);
+}
+
+LinkCutForest::Node LinkCutForest::pathMinimum(Node u, Node v)
+{
+	makeRoot(u);
+	access(v);
+	splay(v);
+
+	return nodes[v].minimum;
+}
+
+bool LinkCutForest::isSplayRoot(Node node) const
+{
+	auto parent = nodes[node].parent;
+
+	return noNode == parent || (nodes[parent].child[0] != node && nodes[parent].child[1] != node);
+}
+
+void LinkCutForest::pushDown(Node node)
+{
+	auto& entry = nodes[node];
+	if (!entry.reversed)
+		return;
+
+	std::swap(entry.child[0], entry.child[1]);
+	for (Node child : entry.child) {
+		if (noNode != child)
+			nodes[child].reversed = !nodes[child].reversed;
+	}
+
+	entry.reversed = false;
+}
+
+void LinkCutForest::pullUp(Node node)
+{
+	auto& entry = nodes[node];
+	entry.minimum = node;
+
+	for (Node child : entry.child) {
+		if (noNode != child && nodes[nodes[child].minimum].weight < nodes[entry.minimum].weight)
+			entry.minimum = nodes[child].minimum;
+	}
+}
+
+void LinkCutForest::rotate(Node node)
+{
+	auto parent = nodes[node].parent;
+	auto grandparent = nodes[parent].parent;
+	int side = nodes[parent].child[1] == node ? 1 : 0;
+	auto moved = nodes[node].child[1 - side];
+
+	if (!isSplayRoot(parent))
+		nodes[grandparent].child[nodes[grandparent].child[1] == parent ? 1 : 0] = node;
+	nodes[node].parent = grandparent;
+
+	nodes[node].child[1 - side] = parent;
+	nodes[parent].parent = node;
+
+	nodes[parent].child[side] = moved;
+	if (noNode != moved)
+		nodes[moved].parent = parent;
+
+	pullUp(parent);
+	pullUp(node);
+}
+
+void LinkCutForest::splay(Node node)
+{
+	splayPath.clear();
+	splayPath.push_back(node);
+	for (auto ancestor = node; !isSplayRoot(ancestor); ancestor = nodes[ancestor].parent)
+		splayPath.push_back(nodes[ancestor].parent);
+
+	for (auto it = splayPath.rbegin(); it != splayPath.rend(); ++it)
+		pushDown(*it);
+
+	while (!isSplayRoot(node)) {
+		auto parent = nodes[node].parent;
+
+		if (!isSplayRoot(parent)) {
+			auto grandparent = nodes[parent].parent;
+			bool zigZig = (nodes[grandparent].child[1] == parent) == (nodes[parent].child[1] == node);
+			rotate(zigZig ? parent : node);
+		}
+
+		rotate(node);
+	}
+}
+
+void LinkCutForest::access(Node node)
+{
+	Node previous = noNode;
+
+	for (auto current = node; noNode != current; current = nodes[current].parent) {
+		splay(current);
+		nodes[current].child[1] = previous;
+		pullUp(current);
+		previous = current;
+	}
+
+	splay(node);
+}
+
+void LinkCutForest::makeRoot(Node node)
+{
+	access(node);
+	nodes[node].reversed = !nodes[node].reversed;
+}
+
+LinkCutForest::Node LinkCutForest::findRoot(Node node)
+{
+	access(node);
+
+	auto root = node;
+	while (true) {
+		pushDown(root);
+		if (noNode == nodes[root].child[0])
+			break;
+
+		root = nodes[root].child[0];
+	}
+
+	splay(root);
+	return root;
+}
+
+SlidingWindowCycleDetector::SlidingWindowCycleDetector(Timestamp _window)
+	: window(_window), now(std::numeric_limits<Timestamp>::min())
+{
+	assert(window > 0);
+
+	cycleListener = [](CycleEvent event, Timestamp time) {};
+}
+
+void SlidingWindowCycleDetector::registerCycleListener(CycleListener listener)
+{
+	cycleListener = listener;
+}
+
+std::uint64_t SlidingWindowCycleDetector::keyOf(VertexID source, VertexID target)
+{
+	auto low = static_cast<std::uint32_t>(std::min(source, target));
+	auto high = static_cast<std::uint32_t>(std::max(source, target));
+
+	return (static_cast<std::uint64_t>(low) << 32) | high;
+}
+
+/*
+ * The forest is kept as a maximum spanning forest of the live edges, weighted
+ * by the time they were last observed. Every edge left out of it closes a
+ * cycle, and it expires no later than the forest edges on that cycle, so a
+ * forest edge never needs a replacement when it expires.
+ */
+void SlidingWindowCycleDetector::insert(const Edge& edge, Timestamp time)
+{
+	advanceTo(time);
+
+	if (edge.source == edge.target)
+		return;
+
+	bool hadCycle = hasCycle();
+	auto key = keyOf(edge.source, edge.target);
+	auto found = edges.find(key);
+
+	if (found != edges.end()) {
+		auto& live = found->second;
+		forest.setWeight(live.node, time);
+
+		if (!live.inForest) {
+			--nonTreeEdges;
+			placeInForest(live);
+		}
+	}
+	else {
+		LiveEdge live;
+		live.sourceID = edge.source;
+		live.targetID = edge.target;
+		live.source = acquireVertex(edge.source);
+		live.target = acquireVertex(edge.target);
+		live.node = forest.makeNode(time);
+		live.inForest = false;
+
+		if (edgeKeys.size() <= live.node)
+			edgeKeys.resize(live.node + 1);
+		edgeKeys[live.node] = key;
+
+		placeInForest(edges.emplace(key, live).first->second);
+	}
+
+	observations.push_back({ time, key });
+	notifyIfChanged(hadCycle, time);
+}
+
+void SlidingWindowCycleDetector::advanceTo(Timestamp time)
+{
+	assert(time >= now);
+
+	bool hadCycle = hasCycle();
+	now = time;
+
+	while (!observations.empty() && observations.front().time <= now - window) {
+		auto observation = observations.front();
+		observations.pop_front();
+
+		auto found = edges.find(observation.key);
+		if (found != edges.end() && forest.weightOf(found->second.node) == observation.time)
+			expire(observation.key);
+	}
+
+	notifyIfChanged(hadCycle, time);
+}
+
+LinkCutForest::Node SlidingWindowCycleDetector::acquireVertex(VertexID id)
+{
+	auto found = vertices.find(id);
+
+	if (found == vertices.end())
+		found = vertices.emplace(id, LiveVertex{ forest.makeNode(vertexWeight), 0 }).first;
+
+	++found->second.degree;
+	return found->second.node;
+}
+
+void SlidingWindowCycleDetector::releaseVertex(VertexID id)
+{
+	auto found = vertices.find(id);
+	assert(found != vertices.end());
+
+	if (0 == --found->second.degree) {
+		forest.releaseNode(found->second.node);
+		vertices.erase(found);
+	}
+}
+
+/*
+ * Put an edge that is not in the forest into it, unless the path it would
+ * close only holds newer edges. The edge that ends up outside the forest
+ * closes a cycle.
+ */
+void SlidingWindowCycleDetector::placeInForest(LiveEdge& edge)
+{
+	if (!forest.isConnected(edge.source, edge.target)) {
+		forest.link(edge.source, edge.node);
+		forest.link(edge.node, edge.target);
+		edge.inForest = true;
+		return;
+	}
+
+	++nonTreeEdges;
+
+	auto oldest = forest.pathMinimum(edge.source, edge.target);
+	if (forest.weightOf(oldest) >= forest.weightOf(edge.node))
+		return;
+
+	auto& replaced = edges.find(edgeKeys[oldest])->second;
+	forest.cut(replaced.source, replaced.node);
+	forest.cut(replaced.node, replaced.target);
+	replaced.inForest = false;
+
+	forest.link(edge.source, edge.node);
+	forest.link(edge.node, edge.target);
+	edge.inForest = true;
+}
+
+void SlidingWindowCycleDetector::expire(std::uint64_t key)
+{
+	auto found = edges.find(key);
+	auto& edge = found->second;
+
+	if (edge.inForest) {
+		forest.cut(edge.source, edge.node);
+		forest.cut(edge.node, edge.target);
+	}
+	else {
+		--nonTreeEdges;
+	}
+
+	forest.releaseNode(edge.node);
+	releaseVertex(edge.sourceID);
+	releaseVertex(edge.targetID);
+	edges.erase(found);
+}
+
+void SlidingWindowCycleDetector::notifyIfChanged(bool hadCycle, Timestamp time)
+{
+	if (hadCycle == hasCycle())
+		return;
+
+	cycleListener(hasCycle() ? CycleEvent::Appeared : CycleEvent::Disappeared, time);
+}
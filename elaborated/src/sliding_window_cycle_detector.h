@@ -0,0 +1,165 @@
+#ifndef __SLIDING_WINDOW_CYCLE_DETECTOR_H__
+#define __SLIDING_WINDOW_CYCLE_DETECTOR_H__
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "graph.h"
+
+/*
+ * A forest of rooted trees that supports linking, cutting and path queries in
+ * amortized O(log n) time, after Sleator and Tarjan. Every node carries a
+ * weight, and path queries return the node of minimum weight on the path.
+ */
+class LinkCutForest {
+public:
+	using Node = std::uint32_t;
+	using Weight = std::int64_t;
+
+	static const Node noNode = static_cast<Node>(-1);
+
+	/*
+	 * Create an isolated node, reusing the storage of a released one if possible
+	 */
+	Node makeNode(Weight weight);
+
+	/*
+	 * Release an isolated node
+	 */
+	void releaseNode(Node node);
+
+	Weight weightOf(Node node) const { return nodes[node].weight; }
+	void setWeight(Node node, Weight weight);
+
+	bool isConnected(Node u, Node v);
+
+	/*
+	 * Connect the trees of two nodes that are not connected yet
+	 */
+	void link(Node u, Node v);
+
+	/*
+	 * Remove the link between two adjacent nodes
+	 */
+	void cut(Node u, Node v);
+
+	/*
+	 * @return the node of minimum weight on the path between two connected nodes
+	 */
+	Node pathMinimum(Node u, Node v);
+
+private:
+	struct Entry {
+		Node child[2];
+		Node parent;
+		Node minimum;
+		Weight weight;
+		bool reversed;
+	};
+
+	bool isSplayRoot(Node node) const;
+	void pushDown(Node node);
+	void pullUp(Node node);
+	void rotate(Node node);
+	void splay(Node node);
+	void access(Node node);
+	void makeRoot(Node node);
+	Node findRoot(Node node);
+
+	std::vector<Entry> nodes;
+	std::vector<Node> released;
+	std::vector<Node> splayPath;
+};
+
+enum class CycleEvent {
+	Appeared,
+	Disappeared
+};
+
+class SlidingWindowCycleDetector {
+public:
+	using Timestamp = std::int64_t;
+	using CycleListener = std::function<void(CycleEvent event, Timestamp time)>;
+
+	/*
+	 * Watch an undirected graph whose edges expire once they are older than the
+	 * window. An edge observed at time t is live until time t + window.
+	 *
+	 * @param window the lifetime of an edge
+	 */
+	explicit SlidingWindowCycleDetector(Timestamp window);
+
+	/*
+	 * This function allows the caller to register a callback function that will be
+	 * called whenever the live edges start or stop containing a cycle. The provided
+	 * `listener` is invoked with the event and the time at which it happened.
+	 *
+	 * @param listener the callback function to be invoked on cycle events
+	 */
+	void registerCycleListener(CycleListener listener);
+
+	/*
+	 * Observe an edge at the given time, after expiring the edges that are no longer
+	 * live at that time. Observing an edge that is still live renews it. Self-loops
+	 * are ignored, as in `UndirectedGraph`.
+	 *
+	 * @param edge the edge observed
+	 * @param time the time of the observation, which must not be earlier than the
+	 *        previous one
+	 */
+	void insert(const Edge& edge, Timestamp time);
+
+	/*
+	 * Expire the edges that are no longer live at the given time
+	 *
+	 * @param time the current time, which must not be earlier than the previous one
+	 */
+	void advanceTo(Timestamp time);
+
+	bool hasCycle() const { return nonTreeEdges > 0; }
+	std::size_t edgeCount() const { return edges.size(); }
+
+private:
+	struct LiveEdge {
+		LinkCutForest::Node node;
+		LinkCutForest::Node source;
+		LinkCutForest::Node target;
+		VertexID sourceID;
+		VertexID targetID;
+		bool inForest;
+	};
+
+	struct Observation {
+		Timestamp time;
+		std::uint64_t key;
+	};
+
+	struct LiveVertex {
+		LinkCutForest::Node node;
+		std::size_t degree;
+	};
+
+	static std::uint64_t keyOf(VertexID source, VertexID target);
+
+	LinkCutForest::Node acquireVertex(VertexID id);
+	void releaseVertex(VertexID id);
+	void placeInForest(LiveEdge& edge);
+	void expire(std::uint64_t key);
+	void notifyIfChanged(bool hadCycle, Timestamp time);
+
+	Timestamp window;
+	Timestamp now;
+	CycleListener cycleListener;
+
+	LinkCutForest forest;
+	std::unordered_map<VertexID, LiveVertex> vertices;
+	std::unordered_map<std::uint64_t, LiveEdge> edges;
+	std::vector<std::uint64_t> edgeKeys;
+	std::deque<Observation> observations;
+	std::size_t nonTreeEdges = 0;
+};
+
+#endif
@@ -0,0 +1,165 @@
+#ifndef __SMALL_GRAPH_H__
+#define __SMALL_GRAPH_H__
+
+#include <cstddef>
+#include <cstdint>
+
+#include "graph.h"
+
+/*
+ * An undirected graph of at most 64 vertices, stored without allocation as one
+ * 64-bit adjacency mask per vertex. Vertex IDs are mapped to indices in the
+ * order in which they first appear. Everything, including cycle detection, can
+ * be evaluated at compile time.
+ */
+class SmallUndirectedGraph {
+public:
+	using Mask = std::uint64_t;
+
+	static constexpr std::size_t maxVertexCount = 64;
+
+	/*
+	 * Initialize an undirected graph from a range of edges. Self-loops and
+	 * repeated edges are ignored. If the edges mention more than `maxVertexCount`
+	 * vertices the graph does not fit, and only `fits()` may be queried.
+	 *
+	 * @param first pointer to the first edge
+	 * @param last pointer past the last edge
+	 */
+	constexpr SmallUndirectedGraph(const Edge* first, const Edge* last)
+		: ids(), adjacency(), count(0), bFits(true)
+	{
+		for (; first != last; ++first) {
+			auto source = acquire(first->source);
+			auto target = acquire(first->target);
+
+			if (maxVertexCount == source || maxVertexCount == target) {
+				bFits = false;
+				return;
+			}
+
+			if (source != target) {
+				adjacency[source] |= Mask(1) << target;
+				adjacency[target] |= Mask(1) << source;
+			}
+		}
+	}
+
+	template <std::size_t N>
+	constexpr explicit SmallUndirectedGraph(const Edge (&edges)[N])
+		: SmallUndirectedGraph(edges, edges + N) {}
+
+	constexpr bool fits() const { return bFits; }
+	constexpr std::size_t vertexCount() const { return count; }
+
+	constexpr std::size_t edgeCount() const
+	{
+		std::size_t arcs = 0;
+		for (std::size_t vertex = 0; vertex < count; ++vertex)
+			arcs += countBits(adjacency[vertex]);
+
+		return arcs / 2;
+	}
+
+	constexpr bool hasVertex(VertexID id) const { return indexOf(id) < count; }
+
+	/*
+	 * @param id the ID of a vertex
+	 * @return the index of the vertex, or `vertexCount()` if it is not present
+	 */
+	constexpr std::size_t indexOf(VertexID id) const
+	{
+		std::size_t index = 0;
+		while (index < count && ids[index] != id)
+			++index;
+
+		return index;
+	}
+
+	constexpr VertexID idOf(std::size_t index) const { return ids[index]; }
+
+	/*
+	 * @param index the index of a vertex
+	 * @return the mask with a bit set for the index of every adjacent vertex
+	 */
+	constexpr Mask neighborsOf(std::size_t index) const { return adjacency[index]; }
+
+	/*
+	 * Count the components by flooding them one at a time, a whole frontier of
+	 * neighbors per step
+	 */
+	constexpr std::size_t componentCount() const
+	{
+		Mask remaining = count < maxVertexCount ? (Mask(1) << count) - 1 : ~Mask(0);
+		std::size_t components = 0;
+
+		while (remaining) {
+			Mask frontier = remaining & (~remaining + 1);
+			Mask component = frontier;
+
+			while (frontier) {
+				auto vertex = lowestBitIndex(frontier);
+				frontier &= frontier - 1;
+
+				Mask reached = adjacency[vertex] & ~component;
+				component |= reached;
+				frontier |= reached;
+			}
+
+			remaining &= ~component;
+			++components;
+		}
+
+		return components;
+	}
+
+	/*
+	 * A graph is a forest exactly when it has one edge fewer than vertices in
+	 * every component
+	 *
+	 * @return true if the graph contains a cycle, false otherwise
+	 */
+	constexpr bool hasCycle() const { return edgeCount() + componentCount() > vertexCount(); }
+
+private:
+	static constexpr std::size_t countBits(Mask mask)
+	{
+		mask = mask - ((mask >> 1) & 0x5555555555555555ull);
+		mask = (mask & 0x3333333333333333ull) + ((mask >> 2) & 0x3333333333333333ull);
+		mask = (mask + (mask >> 4)) & 0x0f0f0f0f0f0f0f0full;
+
+		return static_cast<std::size_t>((mask * 0x0101010101010101ull) >> 56);
+	}
+
+	static constexpr std::size_t lowestBitIndex(Mask mask) { return countBits((mask & (~mask + 1)) - 1); }
+
+	/*
+	 * @return the index of the vertex, added if it is new, or `maxVertexCount` if
+	 *         there is no room left for it
+	 */
+	constexpr std::size_t acquire(VertexID id)
+	{
+		auto index = indexOf(id);
+
+		if (index == count && count < maxVertexCount)
+			ids[count++] = id;
+
+		return index < count ? index : maxVertexCount;
+	}
+
+	VertexID ids[maxVertexCount];
+	Mask adjacency[maxVertexCount];
+	std::size_t count;
+	bool bFits;
+};
+
+/*
+ * @param graph the graph to check, which must fit
+ * @return true if the graph contains a cycle, false otherwise
+ */
+constexpr bool hasCycle(const SmallUndirectedGraph& graph)
+{
+	return graph.hasCycle();
+}
+
+#endif
@@ -0,0 +1,458 @@
+#ifndef __SPANNING_FOREST_H__
+#define __SPANNING_FOREST_H__
+
+#include <cassert>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "disjoint_sets.h"
+#include "indexed_graph.h"
+
+/*
+ * A breadth-first spanning forest of an undirected graph over dense indices,
+ * with one tree per component, stored as parent and depth arrays. Each edge
+ * left out of the forest closes one fundamental cycle, and together these
+ * cycles form a cycle basis of the graph. Self-loops and repeated neighbors
+ * are not edges of their own, as `indexed_graph.h` describes.
+ *
+ * Lowest common ancestors are answered in constant time from an Euler tour of
+ * each tree and a sparse table of depth minima over it. A component with a tour
+ * of length L takes L log L entries of the table, so small components stay
+ * cheap next to a large one. A fundamental cycle can therefore be listed in time
+ * proportional to its length.
+ */
+template <typename Graph>
+class SpanningForest {
+public:
+	using index_type = typename Graph::index_type;
+
+	static constexpr index_type noParent = std::numeric_limits<index_type>::max();
+
+	struct FundamentalCycle {
+		index_type source;
+		index_type target;
+		index_type lowestCommonAncestor;
+	};
+
+	class iterator {
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = FundamentalCycle;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const FundamentalCycle*;
+		using reference = const FundamentalCycle&;
+
+		iterator() = default;
+		explicit iterator(const SpanningForest* forest);
+
+		reference operator*() const { return cycle; }
+		pointer operator->() const { return &cycle; }
+
+		iterator& operator++();
+		iterator operator++(int)
+		{
+			auto previous = *this;
+			++(*this);
+
+			return previous;
+		}
+
+		bool operator==(const iterator& other) const { return forest == other.forest; }
+		bool operator!=(const iterator& other) const { return forest != other.forest; }
+
+	private:
+		void findNonTreeEdge();
+
+		const SpanningForest* forest = nullptr;
+		std::shared_ptr<std::vector<index_type>> reportedFrom;
+		std::size_t vertex = 0;
+		NeighborIterator<Graph> nextNeighbor{};
+		NeighborIterator<Graph> lastNeighbor{};
+		FundamentalCycle cycle;
+	};
+
+	class FundamentalCycleRange {
+	public:
+		explicit FundamentalCycleRange(const SpanningForest* _forest): forest(_forest) {}
+
+		iterator begin() const { return iterator(forest); }
+		iterator end() const { return iterator(); }
+
+	private:
+		const SpanningForest* forest;
+	};
+
+	/*
+	 * Build the spanning forest of a graph. The components are found first, and
+	 * then each one is searched, toured and indexed by one of the threads.
+	 *
+	 * @param graph the graph to span, which must outlive the forest
+	 * @param threadCount the number of threads processing components
+	 */
+	explicit SpanningForest(const Graph& graph, unsigned threadCount = std::thread::hardware_concurrency());
+
+	std::size_t componentCount() const { return roots.size(); }
+
+	/*
+	 * @return the number of edges outside the forest, which is also the number of
+	 *         fundamental cycles
+	 */
+	std::size_t fundamentalCycleCount() const { return nonTreeEdgeCount; }
+
+	index_type rootOf(index_type vertex) const { return roots[components[vertex]]; }
+	index_type parentOf(index_type vertex) const { return parents[vertex]; }
+	index_type depthOf(index_type vertex) const { return depths[vertex]; }
+
+	bool isTreeEdge(index_type u, index_type v) const { return parents[u] == v || parents[v] == u; }
+
+	/*
+	 * @param u a vertex of the graph
+	 * @param v a vertex in the same component as u
+	 * @return the deepest vertex that is an ancestor of both u and v
+	 */
+	index_type lowestCommonAncestor(index_type u, index_type v) const;
+
+	/*
+	 * Enumerate the fundamental cycles one at a time, without storing them. An
+	 * enumeration keeps one index per vertex to skip repeated neighbors.
+	 */
+	FundamentalCycleRange fundamentalCycles() const { return FundamentalCycleRange(this); }
+
+	/*
+	 * List the vertices of a fundamental cycle, from the source of its edge up to
+	 * the lowest common ancestor and back down to the target.
+	 *
+	 * @param cycle a cycle produced by `fundamentalCycles()`
+	 * @param vertices receives the vertices of the cycle
+	 */
+	void traceCycle(const FundamentalCycle& cycle, std::vector<index_type>& vertices) const;
+
+private:
+	static constexpr index_type unvisited = std::numeric_limits<index_type>::max();
+	static constexpr std::size_t untoured = std::numeric_limits<std::size_t>::max();
+
+	static std::size_t floorLog2(std::size_t value)
+	{
+		std::size_t result = 0;
+		while (value >>= 1)
+			++result;
+
+		return result;
+	}
+
+	index_type shallower(index_type u, index_type v) const { return depths[u] <= depths[v] ? u : v; }
+
+	/*
+	 * @return the sparse table level holding the shallowest vertex of every range
+	 *         of the tour of length 2^level, by the start of the range
+	 */
+	const std::vector<index_type>& levelOf(std::size_t level) const { return 0 == level ? tour : sparseTable[level - 1]; }
+
+	void findComponents();
+	std::size_t spanComponent(std::size_t component);
+
+	const Graph& graph;
+	std::vector<index_type> components;
+	std::vector<index_type> roots;
+	std::vector<std::size_t> tourStarts;
+	std::vector<std::size_t> tourEnds;
+	std::vector<index_type> parents;
+	std::vector<index_type> depths;
+	std::vector<std::size_t> firstVisits;
+	std::vector<index_type> countedFrom;
+	std::vector<index_type> tour;
+	std::vector<std::vector<index_type>> sparseTable;
+	std::size_t nonTreeEdgeCount = 0;
+};
+
+
+template <typename Graph>
+constexpr typename SpanningForest<Graph>::index_type SpanningForest<Graph>::noParent;
+
+template <typename Graph>
+constexpr typename SpanningForest<Graph>::index_type SpanningForest<Graph>::unvisited;
+
+template <typename Graph>
+constexpr std::size_t SpanningForest<Graph>::untoured;
+
+template <typename Graph>
+SpanningForest<Graph>::SpanningForest(const Graph& _graph, unsigned threadCount)
+	: graph(_graph), components(_graph.vertexCount()), parents(_graph.vertexCount(), noParent),
+	  depths(_graph.vertexCount(), unvisited), firstVisits(_graph.vertexCount(), untoured),
+	  countedFrom(_graph.vertexCount(), unvisited)
+{
+	findComponents();
+
+	// Tours are laid out from the longest to the shortest, so the components
+	// with a tour of at least 2^level make up a prefix of every level.
+	std::vector<std::size_t> levelSizes;
+	for (std::size_t component = 0; component < roots.size(); ++component) {
+		auto levels = floorLog2(tourEnds[component] - tourStarts[component]);
+		if (levelSizes.size() < levels)
+			levelSizes.resize(levels, 0);
+
+		for (std::size_t level = 1; level <= levels; ++level)
+			levelSizes[level - 1] = std::max(levelSizes[level - 1], tourEnds[component]);
+	}
+
+	sparseTable.resize(levelSizes.size());
+	for (std::size_t level = 0; level < levelSizes.size(); ++level)
+		sparseTable[level].resize(levelSizes[level]);
+
+	std::atomic<std::size_t> nextComponent(0);
+	std::atomic<std::size_t> arcCount(0);
+
+	auto work = [this, &nextComponent, &arcCount]() {
+		std::size_t arcs = 0;
+
+		for (auto component = nextComponent++; component < roots.size(); component = nextComponent++)
+			arcs += spanComponent(component);
+
+		arcCount += arcs;
+	};
+
+	auto workerCount = std::min<std::size_t>(std::max(1u, threadCount), roots.size());
+	std::vector<std::thread> workers;
+	for (std::size_t i = 1; i < workerCount; ++i)
+		workers.emplace_back(work);
+
+	work();
+	for (auto&& worker : workers)
+		worker.join();
+
+	nonTreeEdgeCount = arcCount / 2 - (graph.vertexCount() - roots.size());
+
+	countedFrom.clear();
+	countedFrom.shrink_to_fit();
+}
+
+/*
+ * Components are labelled by their vertex with the smallest index, which
+ * becomes the root of their tree.
+ */
+template <typename Graph>
+void SpanningForest<Graph>::findComponents()
+{
+	BasicDisjointSets<index_type> sets(graph.vertexCount());
+
+	for (std::size_t vertex = 0; vertex < graph.vertexCount(); ++vertex) {
+		for (index_type neighbor : graph.neighborsOf(static_cast<index_type>(vertex))) {
+			if (vertex < neighbor)
+				sets.unite(static_cast<index_type>(vertex), neighbor);
+		}
+	}
+
+	std::vector<index_type> componentOfRoot(graph.vertexCount(), unvisited);
+	std::vector<std::size_t> sizes;
+
+	for (std::size_t vertex = 0; vertex < graph.vertexCount(); ++vertex) {
+		auto& component = componentOfRoot[sets.find(static_cast<index_type>(vertex))];
+
+		if (unvisited == component) {
+			component = static_cast<index_type>(roots.size());
+			roots.push_back(static_cast<index_type>(vertex));
+			sizes.push_back(0);
+		}
+
+		components[vertex] = component;
+		++sizes[component];
+	}
+
+	std::vector<std::size_t> layout(roots.size());
+	for (std::size_t component = 0; component < layout.size(); ++component)
+		layout[component] = component;
+	std::stable_sort(layout.begin(), layout.end(), [&sizes](std::size_t a, std::size_t b) { return sizes[a] > sizes[b]; });
+
+	tourStarts.resize(roots.size());
+	tourEnds.resize(roots.size());
+
+	std::size_t position = 0;
+	for (auto component : layout) {
+		tourStarts[component] = position;
+		position += 2 * sizes[component] - 1;
+		tourEnds[component] = position;
+	}
+
+	tour.resize(position);
+}
+
+/*
+ * Search one component breadth first, then walk its tree depth first to lay
+ * out the Euler tour, and finally fill in the part of the sparse table that
+ * covers the tour. Components touch disjoint parts of every array, so they can
+ * be processed concurrently.
+ *
+ * The arcs counted are those to distinct neighbors other than the vertex
+ * itself, and a child listed twice is entered only once by the walk.
+ */
+template <typename Graph>
+std::size_t SpanningForest<Graph>::spanComponent(std::size_t component)
+{
+	std::size_t arcs = 0;
+	auto root = roots[component];
+
+	std::vector<index_type> queue(1, root);
+	depths[root] = 0;
+
+	for (std::size_t head = 0; head < queue.size(); ++head) {
+		auto vertex = queue[head];
+		for (index_type neighbor : graph.neighborsOf(vertex)) {
+			if (neighbor == vertex || countedFrom[neighbor] == vertex)
+				continue;
+
+			countedFrom[neighbor] = vertex;
+			++arcs;
+
+			if (unvisited != depths[neighbor])
+				continue;
+
+			depths[neighbor] = depths[vertex] + 1;
+			parents[neighbor] = vertex;
+			queue.push_back(neighbor);
+		}
+	}
+
+	struct Frame {
+		index_type vertex;
+		NeighborIterator<Graph> nextNeighbor;
+		NeighborIterator<Graph> lastNeighbor;
+	};
+
+	auto first = tourStarts[component];
+	auto last = tourEnds[component];
+	auto position = first;
+	std::vector<Frame> stack;
+
+	auto enter = [&](index_type vertex) {
+		auto neighbors = graph.neighborsOf(vertex);
+		firstVisits[vertex] = position;
+		tour[position++] = vertex;
+		stack.push_back({ vertex, neighbors.begin(), neighbors.end() });
+	};
+
+	enter(root);
+	while (!stack.empty()) {
+		auto& frame = stack.back();
+
+		if (frame.nextNeighbor != frame.lastNeighbor) {
+			auto neighbor = *frame.nextNeighbor++;
+			if (parents[neighbor] == frame.vertex && untoured == firstVisits[neighbor])
+				enter(neighbor);
+			continue;
+		}
+
+		stack.pop_back();
+		if (!stack.empty())
+			tour[position++] = stack.back().vertex;
+	}
+
+	assert(position == last);
+
+	for (std::size_t level = 1; level <= sparseTable.size(); ++level) {
+		auto& previous = levelOf(level - 1);
+		std::size_t half = std::size_t(1) << (level - 1);
+
+		for (auto i = first; i + 2 * half <= last; ++i)
+			sparseTable[level - 1][i] = shallower(previous[i], previous[i + half]);
+	}
+
+	return arcs;
+}
+
+template <typename Graph>
+typename SpanningForest<Graph>::index_type SpanningForest<Graph>::lowestCommonAncestor(index_type u, index_type v) const
+{
+	assert(components[u] == components[v]);
+
+	auto first = std::min(firstVisits[u], firstVisits[v]);
+	auto last = std::max(firstVisits[u], firstVisits[v]);
+	auto level = floorLog2(last - first + 1);
+
+	auto& minima = levelOf(level);
+
+	return shallower(minima[first], minima[last + 1 - (std::size_t(1) << level)]);
+}
+
+template <typename Graph>
+void SpanningForest<Graph>::traceCycle(const FundamentalCycle& cycle, std::vector<index_type>& vertices) const
+{
+	vertices.clear();
+
+	for (auto vertex = cycle.source; vertex != cycle.lowestCommonAncestor; vertex = parents[vertex])
+		vertices.push_back(vertex);
+	vertices.push_back(cycle.lowestCommonAncestor);
+
+	auto descent = vertices.size();
+	for (auto vertex = cycle.target; vertex != cycle.lowestCommonAncestor; vertex = parents[vertex])
+		vertices.push_back(vertex);
+
+	std::reverse(vertices.begin() + descent, vertices.end());
+}
+
+template <typename Graph>
+SpanningForest<Graph>::iterator::iterator(const SpanningForest* _forest)
+	: forest(_forest)
+{
+	if (forest->graph.vertexCount() == 0) {
+		forest = nullptr;
+		return;
+	}
+
+	reportedFrom = std::make_shared<std::vector<index_type>>(forest->graph.vertexCount(), unvisited);
+
+	auto neighbors = forest->graph.neighborsOf(0);
+	nextNeighbor = neighbors.begin();
+	lastNeighbor = neighbors.end();
+
+	findNonTreeEdge();
+}
+
+template <typename Graph>
+typename SpanningForest<Graph>::iterator& SpanningForest<Graph>::iterator::operator++()
+{
+	assert(forest != nullptr);
+
+	findNonTreeEdge();
+	return *this;
+}
+
+/*
+ * Every non-tree edge is reported once, from its endpoint with the smaller
+ * index. Each target remembers the last source that reported it, so that a
+ * repeated neighbor is reported only once.
+ */
+template <typename Graph>
+void SpanningForest<Graph>::iterator::findNonTreeEdge()
+{
+	auto& graph = forest->graph;
+
+	while (true) {
+		while (nextNeighbor != lastNeighbor) {
+			auto source = static_cast<index_type>(vertex);
+			auto target = *nextNeighbor++;
+
+			if (source < target && !forest->isTreeEdge(source, target) && (*reportedFrom)[target] != source) {
+				(*reportedFrom)[target] = source;
+				cycle = { source, target, forest->lowestCommonAncestor(source, target) };
+				return;
+			}
+		}
+
+		if (++vertex >= graph.vertexCount()) {
+			forest = nullptr;
+			return;
+		}
+
+		auto neighbors = graph.neighborsOf(static_cast<index_type>(vertex));
+		nextNeighbor = neighbors.begin();
+		lastNeighbor = neighbors.end();
+	}
+}
+
+#endif
@@ -0,0 +1,206 @@
+#include "versioned_graph.h"
+#include <cassert>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+#include "compact_graph.h"
+
+const std::size_t GraphVersion::blockSize;
+
+/*
+ * The hash is scrambled by Fibonacci hashing, since the standard hash of an
+ * integer is the integer itself and IDs often share their low bits.
+ */
+std::size_t GraphVersion::shardNumberOf(VertexID id, std::size_t shardCount)
+{
+	auto hash = static_cast<std::uint64_t>(std::hash<VertexID>()(id)) * UINT64_C(0x9E3779B97F4A7C15);
+
+	return static_cast<std::size_t>(hash >> 32) & (shardCount - 1);
+}
+
+IndexRange GraphVersion::neighborsOf(VertexIndex index) const
+{
+	assert(index < vertices);
+
+	auto& block = *blocks[index / blockSize];
+	auto offset = index % blockSize;
+	auto first = block.neighbors.data();
+
+	return IndexRange(first + block.offsets[offset], first + block.offsets[offset + 1]);
+}
+
+VersionedGraph::VersionedGraph(const std::vector<Edge>& edges)
+{
+	std::shared_ptr<GraphVersion> first(new GraphVersion());
+	first->shards.push_back(std::make_shared<const GraphVersion::IndexShard>());
+	current = first;
+
+	if (!edges.empty())
+		addEdges(edges);
+}
+
+VersionedGraph::Snapshot VersionedGraph::pin() const
+{
+	return std::atomic_load(&current);
+}
+
+VersionedGraph::Snapshot VersionedGraph::addEdges(const std::vector<Edge>& batch)
+{
+	return publish(batch, Change::Addition);
+}
+
+VersionedGraph::Snapshot VersionedGraph::removeEdges(const std::vector<Edge>& batch)
+{
+	return publish(batch, Change::Removal);
+}
+
+/*
+ * The batch is turned into a sorted list of arcs, and only the blocks holding
+ * the source of some arc, or new vertices, are rebuilt. Each rebuilt vertex
+ * merges its old neighbors with its changes in one linear pass.
+ *
+ * New IDs are added to copies of the shards that hold them. Once the shards
+ * hold more than `blockSize` IDs on average, their number is doubled and every
+ * ID is moved, so that a batch copies O(blockSize) IDs per new vertex in
+ * amortized time rather than the whole index.
+ */
+VersionedGraph::Snapshot VersionedGraph::publish(const std::vector<Edge>& batch, Change change)
+{
+	std::lock_guard<std::mutex> lock(writerMutex);
+
+	auto base = pin();
+	std::shared_ptr<GraphVersion> next(new GraphVersion(*base));
+	++next->sequence;
+
+	std::vector<std::shared_ptr<GraphVersion::IndexShard>> copiedShards(next->shards.size());
+	std::vector<VertexID> addedIds;
+
+	auto lookUp = [&](VertexID id, VertexIndex& index) {
+		auto shardNumber = GraphVersion::shardNumberOf(id, next->shards.size());
+		auto& shard = *next->shards[shardNumber];
+
+		auto found = shard.find(id);
+		if (found != shard.end()) {
+			index = found->second;
+			return true;
+		}
+
+		if (Change::Removal == change)
+			return false;
+
+		auto& copy = copiedShards[shardNumber];
+		if (!copy) {
+			copy = std::make_shared<GraphVersion::IndexShard>(shard);
+			next->shards[shardNumber] = copy;
+		}
+
+		index = static_cast<VertexIndex>(next->vertices++);
+		copy->emplace(id, index);
+		addedIds.push_back(id);
+		return true;
+	};
+
+	std::vector<std::pair<VertexIndex, VertexIndex>> arcs;
+	arcs.reserve(2 * batch.size());
+
+	for (auto&& edge : batch) {
+		VertexIndex source, target;
+
+		if (edge.source == edge.target || !lookUp(edge.source, source) || !lookUp(edge.target, target))
+			continue;
+
+		arcs.push_back({ source, target });
+		arcs.push_back({ target, source });
+	}
+
+	std::sort(arcs.begin(), arcs.end());
+	arcs.erase(std::unique(arcs.begin(), arcs.end()), arcs.end());
+
+	if (next->vertices > next->shards.size() * GraphVersion::blockSize) {
+		auto shardCount = next->shards.size();
+		while (next->vertices > shardCount * GraphVersion::blockSize)
+			shardCount *= 2;
+
+		std::vector<std::shared_ptr<GraphVersion::IndexShard>> grown(shardCount);
+		for (auto& shard : grown) {
+			shard = std::make_shared<GraphVersion::IndexShard>();
+			shard->reserve(GraphVersion::blockSize);
+		}
+
+		for (auto&& shard : next->shards) {
+			for (auto&& entry : *shard)
+				grown[GraphVersion::shardNumberOf(entry.first, shardCount)]->insert(entry);
+		}
+
+		next->shards.assign(grown.begin(), grown.end());
+	}
+
+	std::vector<std::size_t> touchedBlocks;
+	for (auto&& arc : arcs) {
+		auto block = arc.first / GraphVersion::blockSize;
+		if (touchedBlocks.empty() || touchedBlocks.back() != block)
+			touchedBlocks.push_back(block);
+	}
+	for (auto vertex = base->vertices; vertex < next->vertices; vertex += GraphVersion::blockSize - vertex % GraphVersion::blockSize)
+		touchedBlocks.push_back(vertex / GraphVersion::blockSize);
+
+	std::sort(touchedBlocks.begin(), touchedBlocks.end());
+	touchedBlocks.erase(std::unique(touchedBlocks.begin(), touchedBlocks.end()), touchedBlocks.end());
+
+	next->blocks.resize((next->vertices + GraphVersion::blockSize - 1) / GraphVersion::blockSize);
+
+	std::ptrdiff_t arcDelta = 0;
+	auto arc = arcs.begin();
+
+	for (auto blockNumber : touchedBlocks) {
+		auto first = blockNumber * GraphVersion::blockSize;
+		auto last = std::min(first + GraphVersion::blockSize, next->vertices);
+		auto old = blockNumber < base->blocks.size() ? base->blocks[blockNumber] : nullptr;
+
+		std::shared_ptr<GraphVersion::AdjacencyBlock> block(new GraphVersion::AdjacencyBlock());
+		if (old)
+			block->ids = old->ids;
+		for (auto vertex = first + block->ids.size(); vertex < last; ++vertex)
+			block->ids.push_back(addedIds[vertex - base->vertices]);
+
+		block->offsets.reserve(last - first + 1);
+		block->offsets.push_back(0);
+
+		for (auto vertex = first; vertex < last; ++vertex) {
+			std::vector<VertexIndex> changes;
+			for (; arc != arcs.end() && arc->first == vertex; ++arc)
+				changes.push_back(arc->second);
+
+			IndexRange oldNeighbors(nullptr, nullptr);
+			if (old && vertex - first < old->ids.size())
+				oldNeighbors = base->neighborsOf(static_cast<VertexIndex>(vertex));
+
+			auto out = std::back_inserter(block->neighbors);
+			if (Change::Addition == change)
+				std::set_union(oldNeighbors.begin(), oldNeighbors.end(), changes.begin(), changes.end(), out);
+			else
+				std::set_difference(oldNeighbors.begin(), oldNeighbors.end(), changes.begin(), changes.end(), out);
+
+			block->offsets.push_back(block->neighbors.size());
+			arcDelta += static_cast<std::ptrdiff_t>(block->offsets.back() - block->offsets[vertex - first]) -
+				        static_cast<std::ptrdiff_t>(oldNeighbors.size());
+		}
+
+		next->blocks[blockNumber] = block;
+	}
+
+	next->edges = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(next->edges) + arcDelta / 2);
+
+	Snapshot published(next);
+	std::atomic_store(&current, published);
+
+	return published;
+}
+
+bool hasCycle(const GraphVersion& version)
+{
+	return hasCycle<GraphVersion>(version);
+}
@@ -0,0 +1,143 @@
+#ifndef __VERSIONED_GRAPH_H__
+#define __VERSIONED_GRAPH_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "graph.h"
+#include "adjacency_array.h"
+
+/*
+ * An immutable snapshot of a `VersionedGraph`. The adjacency is split into
+ * blocks of `blockSize` consecutive vertices, and the index from vertex IDs to
+ * dense indices into shards of about as many IDs, chosen by a hash of the ID.
+ * A block or shard that an update does not touch is shared with the versions
+ * before and after it.
+ *
+ * A version can be searched like a compact graph, e.g. with
+ * `CompactDepthFirstTraversal`, for as long as it is pinned.
+ */
+class GraphVersion {
+public:
+	using id_type = VertexID;
+	using index_type = VertexIndex;
+	using edge_type = Edge;
+
+	static const std::size_t blockSize = 1024;
+
+	/*
+	 * @return the position of this version among the published versions
+	 */
+	std::uint64_t number() const { return sequence; }
+
+	std::size_t vertexCount() const { return vertices; }
+	std::size_t edgeCount() const { return edges; }
+
+	bool hasVertex(VertexID id) const { return shardOf(id).count(id) > 0; }
+	VertexIndex indexOf(VertexID id) const { return shardOf(id).at(id); }
+	VertexID idOf(VertexIndex index) const { return blocks[index / blockSize]->ids[index % blockSize]; }
+
+	/*
+	 * @param index the dense index of the vertex
+	 * @return the dense indices of the adjacent vertices, in increasing order
+	 */
+	IndexRange neighborsOf(VertexIndex index) const;
+
+private:
+	friend class VersionedGraph;
+
+	struct AdjacencyBlock {
+		std::vector<VertexID> ids;
+		std::vector<std::size_t> offsets;
+		std::vector<VertexIndex> neighbors;
+	};
+
+	using IndexShard = std::unordered_map<VertexID, VertexIndex>;
+
+	/*
+	 * @param id the ID of a vertex
+	 * @param shardCount the number of shards, a power of two
+	 * @return the number of the shard that holds the ID
+	 */
+	static std::size_t shardNumberOf(VertexID id, std::size_t shardCount);
+
+	const IndexShard& shardOf(VertexID id) const { return *shards[shardNumberOf(id, shards.size())]; }
+
+	std::uint64_t sequence = 0;
+	std::size_t vertices = 0;
+	std::size_t edges = 0;
+	std::vector<std::shared_ptr<const IndexShard>> shards;
+	std::vector<std::shared_ptr<const AdjacencyBlock>> blocks;
+};
+
+/*
+ * An undirected graph updated by one writer while any number of readers search
+ * it. Readers pin the current version and keep it unchanged for as long as they
+ * hold it. The writer builds the next version beside it, copying only the
+ * adjacency blocks and index shards that change, and publishes it with an
+ * atomic pointer swap.
+ * A version is reclaimed when the last reader holding it lets go.
+ */
+class VersionedGraph {
+public:
+	using Snapshot = std::shared_ptr<const GraphVersion>;
+
+	/*
+	 * Initialize the graph with a first version holding the given edges
+	 *
+	 * @param edges the set of edges used to initialize the graph
+	 */
+	explicit VersionedGraph(const std::vector<Edge>& edges = std::vector<Edge>());
+
+	/*
+	 * Pin the current version. Pinning never waits for a version being built;
+	 * it only contends for the lock that the standard library may use to make
+	 * the load of a shared pointer atomic, held for the length of one copy.
+	 *
+	 * @return the current version, kept alive by the returned pointer
+	 */
+	Snapshot pin() const;
+
+	/*
+	 * Publish a version with a batch of edges added. Self-loops and edges already
+	 * present are ignored, as in `CompactUndirectedGraph`.
+	 *
+	 * @param batch the edges to add
+	 * @return the published version
+	 */
+	Snapshot addEdges(const std::vector<Edge>& batch);
+
+	/*
+	 * Publish a version with a batch of edges removed. The endpoints stay in the
+	 * graph, and edges that are not present are ignored.
+	 *
+	 * @param batch the edges to remove
+	 * @return the published version
+	 */
+	Snapshot removeEdges(const std::vector<Edge>& batch);
+
+private:
+	enum class Change {
+		Addition,
+		Removal
+	};
+
+	Snapshot publish(const std::vector<Edge>& batch, Change change);
+
+	Snapshot current;
+	std::mutex writerMutex;
+};
+
+/*
+ * Check if a version of a graph contains a cycle by searching it for a back edge
+ *
+ * @param version the version to check
+ * @return true if the version contains a cycle, false otherwise
+ */
+bool hasCycle(const GraphVersion& version);
+
+#endif
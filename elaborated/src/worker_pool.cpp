@@ -0,0 +1,50 @@
+#include "worker_pool.h"
+#include <algorithm>
+
+WorkerPool::WorkerPool(unsigned threadCount)
+{
+	threadCount = std::max(1u, threadCount);
+
+	for (unsigned i = 0; i < threadCount; ++i)
+		workers.emplace_back(&WorkerPool::work, this);
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	available.notify_all();
+
+	for (auto&& worker : workers)
+		worker.join();
+}
+
+void WorkerPool::submit(Task task)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		tasks.push_back(std::move(task));
+	}
+	available.notify_one();
+}
+
+void WorkerPool::work()
+{
+	while (true) {
+		Task task;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			available.wait(lock, [this]() { return stopping || !tasks.empty(); });
+
+			if (tasks.empty())
+				return;
+
+			task = std::move(tasks.front());
+			tasks.pop_front();
+		}
+
+		task();
+	}
+}
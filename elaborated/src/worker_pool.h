@@ -0,0 +1,47 @@
+#ifndef __WORKER_POOL_H__
+#define __WORKER_POOL_H__
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkerPool {
+public:
+	using Task = std::function<void()>;
+
+	/*
+	 * Start a fixed number of worker threads waiting for tasks
+	 *
+	 * @param threadCount the number of worker threads
+	 */
+	explicit WorkerPool(unsigned threadCount);
+
+	/*
+	 * Wait for all submitted tasks to complete, then stop the worker threads
+	 */
+	~WorkerPool();
+
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	/*
+	 * Queue a task to be run by the first available worker thread
+	 *
+	 * @param task the task to run
+	 */
+	void submit(Task task);
+
+private:
+	void work();
+
+	std::mutex mutex;
+	std::condition_variable available;
+	std::deque<Task> tasks;
+	bool stopping = false;
+	std::vector<std::thread> workers;
+};
+
+#endif
@@ -0,0 +1,118 @@
+#include <gmock/gmock.h>
+#include <cstdint>
+
+#include "compact_graph.h"
+#include "directed_graph.h"
+
+using ::testing::Eq;
+
+using WideUndirectedGraph = BasicCompactUndirectedGraph<std::int64_t, std::uint64_t>;
+using WideDirectedGraph = BasicDirectedGraph<std::int64_t, std::uint64_t>;
+
+
+TEST(CompactUndirectedGraphTest, graphIsUndirected) {
+	CompactUndirectedGraph graph({ {2, 5} });
+
+	auto neighborOfV1 = graph.neighborsOf(graph.indexOf(2));
+	auto neighborOfV2 = graph.neighborsOf(graph.indexOf(5));
+
+	ASSERT_THAT(graph.idOf(*neighborOfV1.begin()), Eq(5));
+	ASSERT_THAT(graph.idOf(*neighborOfV2.begin()), Eq(2));
+}
+
+TEST(CompactUndirectedGraphTest, ignoreSelfLoopAndDuplicateEdge) {
+	CompactUndirectedGraph graph({ {10, 9}, {10, 10}, {9, 10} });
+
+	ASSERT_THAT(graph.vertexCount(), Eq(2u));
+	ASSERT_THAT(graph.edgeCount(), Eq(1u));
+	ASSERT_THAT(graph.neighborsOf(graph.indexOf(10)).size(), Eq(1u));
+}
+
+TEST(CompactUndirectedGraphTest, idsWiderThanIntAreKeptApart) {
+	const std::int64_t base = std::int64_t(1) << 40;
+	WideUndirectedGraph graph({ {base, base + 1}, {base + 1, 0}, {0, base} });
+
+	ASSERT_THAT(graph.vertexCount(), Eq(3u));
+	ASSERT_TRUE(graph.hasVertex(base + 1));
+	ASSERT_FALSE(graph.hasVertex(1));
+	ASSERT_TRUE(hasCycle(graph));
+}
+
+TEST(CompactUndirectedGraphTest, findCycleOutsideComponentOfFirstVertex) {
+	CompactUndirectedGraph graph({ {0, 1}, {2, 3}, {3, 4}, {4, 2} });
+
+	ASSERT_TRUE(hasCycle(graph));
+}
+
+TEST(CompactUndirectedGraphTest, forestHasNoCycle) {
+	CompactUndirectedGraph graph({ {0, 1}, {0, 2}, {0, 3}, {1, 4}, {7, 8}, {8, 9} });
+
+	ASSERT_FALSE(hasCycle(graph));
+}
+
+TEST(CompactUndirectedGraphTest, emptyGraphHasNoCycle) {
+	CompactUndirectedGraph graph(std::vector<Edge>{});
+
+	ASSERT_THAT(graph.vertexCount(), Eq(0u));
+	ASSERT_FALSE(hasCycle(graph));
+}
+
+TEST(CompactDepthFirstTraversalTest, sourceIsParentOfTarget) {
+	CompactUndirectedGraph graph({ {1, 2} });
+	CompactDepthFirstTraversal<CompactUndirectedGraph> traversal(graph, graph.indexOf(1));
+
+	auto events = std::vector<BasicTraversalEvent<VertexIndex>>(traversal.begin(), traversal.end());
+
+	ASSERT_THAT(events.size(), Eq(1u));
+	ASSERT_THAT(events.front().kind, Eq(EdgeKind::Tree));
+	ASSERT_THAT(traversal.parentOf(events.front().target), Eq(events.front().source));
+}
+
+TEST(CompactDepthFirstTraversalTest, singleComponentSearchStaysInsideComponent) {
+	CompactUndirectedGraph graph({ {0, 1}, {2, 3} });
+	CompactDepthFirstTraversal<CompactUndirectedGraph> traversal(graph, graph.indexOf(2));
+
+	for (auto it = traversal.begin(); it != traversal.end(); ++it)
+		;
+
+	ASSERT_TRUE(traversal.isDiscovered(graph.indexOf(3)));
+	ASSERT_FALSE(traversal.isDiscovered(graph.indexOf(0)));
+}
+
+TEST(WideDirectedGraphTest, sortIdsWiderThanInt) {
+	const std::int64_t base = std::int64_t(1) << 40;
+	WideDirectedGraph graph({ {base + 2, base}, {base, 7} });
+	TopologicalSorter sorter(1);
+
+	auto result = sorter.sort(graph);
+
+	ASSERT_FALSE(result.hasCycle);
+	ASSERT_THAT(result.order, Eq(std::vector<std::int64_t>{ base + 2, base, 7 }));
+	ASSERT_FALSE(hasCycle(graph));
+}
+
+struct VertexEventCounter : NullSearchObserver<VertexIndex> {
+	void startComponent(VertexIndex root) { ++components; }
+	void discoverVertex(VertexIndex vertex, std::size_t degree) { ++discovered; }
+	void finishVertex(VertexIndex vertex, VertexIndex parent) { ++finished; }
+
+	int components = 0;
+	int discovered = 0;
+	int finished = 0;
+};
+
+TEST(CompactDepthFirstTraversalTest, observerSeesEveryVertexOfSearchedComponent) {
+	CompactUndirectedGraph graph({ {0, 1}, {1, 2}, {2, 0}, {5, 6} });
+	CompactDepthFirstTraversal<CompactUndirectedGraph> traversal(graph, graph.indexOf(1));
+	VertexEventCounter counter;
+	BasicTraversalEvent<VertexIndex> event;
+
+	int edges = 0;
+	while (traversal.next(event, counter))
+		++edges;
+
+	ASSERT_THAT(edges, Eq(3));
+	ASSERT_THAT(counter.components, Eq(1));
+	ASSERT_THAT(counter.discovered, Eq(3));
+	ASSERT_THAT(counter.finished, Eq(3));
+}
@@ -0,0 +1,133 @@
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <map>
+
+#include "directed_graph.h"
+
+using ::testing::Eq;
+
+
+bool respectsEdges(const std::vector<VertexID>& order, const std::vector<Edge>& edges) {
+	std::map<VertexID, std::size_t> position;
+	for (std::size_t i = 0; i < order.size(); ++i)
+		position[order[i]] = i;
+
+	return std::all_of(edges.begin(), edges.end(),
+		               [&position](const Edge& edge) { return position.at(edge.source) < position.at(edge.target); });
+}
+
+std::vector<Edge> makeLayeredDag(int layerCount, int layerWidth) {
+	std::vector<Edge> edges;
+
+	for (int layer = 0; layer + 1 < layerCount; ++layer) {
+		for (int i = 0; i < layerWidth; ++i) {
+			int source = layer * layerWidth + i;
+			edges.push_back({ source, (layer + 1) * layerWidth + i });
+			edges.push_back({ source, (layer + 1) * layerWidth + (i * 7 + 3) % layerWidth });
+		}
+	}
+
+	return edges;
+}
+
+TEST(VertexIndexerTest, compactIDsAreIndexedInOrder) {
+	VertexIndexer indexer({ {12, 10}, {11, 10} });
+
+	ASSERT_THAT(indexer.size(), Eq(3u));
+	ASSERT_THAT(indexer.indexOf(10), Eq(0u));
+	ASSERT_THAT(indexer.indexOf(12), Eq(2u));
+	ASSERT_THAT(indexer.idOf(1), Eq(11));
+	ASSERT_FALSE(indexer.contains(13));
+}
+
+TEST(VertexIndexerTest, sparseIDsAreIndexedByFirstAppearance) {
+	VertexIndexer indexer({ {1000000000, -1000000000}, {7, 1000000000} });
+
+	ASSERT_THAT(indexer.size(), Eq(3u));
+	ASSERT_THAT(indexer.indexOf(1000000000), Eq(0u));
+	ASSERT_THAT(indexer.idOf(2), Eq(7));
+	ASSERT_FALSE(indexer.contains(8));
+}
+
+TEST(DirectedGraphTest, edgesPointFromSourceToTarget) {
+	DirectedGraph graph({ {4, 1}, {4, 2} });
+
+	auto successors = graph.successorsOf(graph.indexOf(4));
+	ASSERT_THAT(successors.size(), Eq(2u));
+	ASSERT_TRUE(graph.successorsOf(graph.indexOf(1)).empty());
+	ASSERT_THAT(graph.edgeCount(), Eq(2u));
+	ASSERT_THAT(graph.vertexCount(), Eq(3u));
+}
+
+TEST(DirectedGraphTest, treeIsAcyclic) {
+	DirectedGraph graph({ {0, 1}, {0, 2}, {0, 3}, {1, 4}, {1, 5}, {4, 8}, {4, 9}, {3, 6}, {3, 7}, {6, 10}, {6, 11}, {5, 9} });
+
+	ASSERT_FALSE(hasCycle(graph));
+}
+
+TEST(DirectedGraphTest, findCycleAcrossComponents) {
+	DirectedGraph graph({ {0, 1}, {2, 3}, {3, 4}, {4, 2} });
+
+	ASSERT_TRUE(hasCycle(graph));
+}
+
+TEST(DirectedGraphTest, selfLoopIsCycle) {
+	DirectedGraph graph({ {0, 1}, {1, 1} });
+
+	ASSERT_TRUE(hasCycle(graph));
+}
+
+TEST(DirectedGraphTest, longChainDoesNotExhaustStack) {
+	std::vector<Edge> edges;
+	for (int i = 0; i < 200000; ++i)
+		edges.push_back({ i, i + 1 });
+	DirectedGraph acyclic(edges);
+	edges.push_back({ 200000, 0 });
+	DirectedGraph cyclic(edges);
+
+	ASSERT_FALSE(hasCycle(acyclic));
+	ASSERT_TRUE(hasCycle(cyclic));
+}
+
+TEST(TopologicalSorterTest, orderRespectsEveryEdge) {
+	std::vector<Edge> edges = { {5, 3}, {3, 1}, {5, 1}, {4, 1}, {1, 0} };
+	TopologicalSorter sorter(1);
+
+	auto result = sorter.sort(DirectedGraph(edges));
+
+	ASSERT_FALSE(result.hasCycle);
+	ASSERT_THAT(result.order.size(), Eq(5u));
+	ASSERT_TRUE(respectsEdges(result.order, edges));
+}
+
+TEST(TopologicalSorterTest, reportCycleAndLeaveOutItsVertices) {
+	TopologicalSorter sorter(1);
+
+	auto result = sorter.sort(DirectedGraph({ {0, 1}, {1, 2}, {2, 1}, {2, 3} }));
+
+	ASSERT_TRUE(result.hasCycle);
+	ASSERT_THAT(result.order, Eq(std::vector<VertexID>{ 0 }));
+}
+
+TEST(TopologicalSorterTest, parallelSortOfWideFrontiers) {
+	auto edges = makeLayeredDag(4, 3 * TopologicalSorter::parallelFrontierSize);
+	DirectedGraph graph(edges);
+	TopologicalSorter sorter(4);
+
+	auto result = sorter.sort(graph);
+
+	ASSERT_FALSE(result.hasCycle);
+	ASSERT_THAT(result.order.size(), Eq(graph.vertexCount()));
+	ASSERT_TRUE(respectsEdges(result.order, edges));
+	ASSERT_FALSE(hasCycle(graph));
+}
+
+TEST(TopologicalSorterTest, parallelSortFindsCycle) {
+	auto edges = makeLayeredDag(4, 3 * TopologicalSorter::parallelFrontierSize);
+	edges.push_back({ edges.back().target, edges.back().source });
+	TopologicalSorter sorter(4);
+
+	auto result = sorter.sort(DirectedGraph(edges));
+
+	ASSERT_TRUE(result.hasCycle);
+}
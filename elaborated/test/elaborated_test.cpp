@@ -261,4 +261,93 @@ TEST_F(DepthFirstVisitorTest, sourceIsParentOfTarget)
 	depthFirstVisitor.search(graph, source);
 
 	ASSERT_TRUE(isParent);
-}
\ No newline at end of file
+}
+
+TEST_F(DepthFirstVisitorTest, backEdgeExaminerIsInvokedWhenGraphContainsCycle)
+{
+	std::vector<Edge> edges = { {0, 1}, {1, 2}, {2, 0} };
+	UndirectedGraph graph(edges);
+	auto source = graph.getVertexById(0);
+
+	int backEdges = 0;
+	depthFirstVisitor.registerBackEdgeExaminer([&backEdges](const shared_vertex source, const shared_vertex target) {
+		++backEdges;
+		});
+	depthFirstVisitor.search(graph, source);
+
+	ASSERT_THAT(backEdges, Eq(1));
+}
+
+std::vector<TraversalEvent> collect(DepthFirstTraversal& traversal) {
+	std::vector<TraversalEvent> result;
+
+	for (auto&& event : traversal)
+		result.push_back(event);
+
+	return result;
+}
+
+bool isSameEvent(const TraversalEvent& lhs, const TraversalEvent& rhs) {
+	return lhs.kind == rhs.kind &&
+		   lhs.source->getID() == rhs.source->getID() &&
+		   lhs.target->getID() == rhs.target->getID();
+}
+
+TEST(DepthFirstTraversalTest, onlySourceIsDiscoveredBeforeEventsAreRequested)
+{
+	std::vector<Edge> edges = { {0, 1}, {1, 2} };
+	UndirectedGraph graph(edges);
+
+	DepthFirstTraversal traversal(graph, graph.getVertexById(0));
+
+	ASSERT_TRUE(graph.getVertexById(0)->isDiscovered());
+	ASSERT_FALSE(graph.getVertexById(1)->isDiscovered());
+}
+
+TEST(DepthFirstTraversalTest, yieldsOneTreeEdgePerVertexOfTree)
+{
+	std::vector<Edge> edges = { {0, 1}, {0, 2}, {0, 3}, {1, 4}, {1, 5}, {4, 8}, {4, 9}, {3, 6}, {3, 7}, {6, 10}, {6, 11} };
+	UndirectedGraph graph(edges);
+
+	DepthFirstTraversal traversal(graph, graph.getVertexById(0));
+	auto events = collect(traversal);
+
+	ASSERT_THAT(events.size(), Eq(11u));
+	ASSERT_TRUE(std::all_of(events.begin(), events.end(),
+		                    [](const TraversalEvent& event) { return EdgeKind::Tree == event.kind; }));
+	ASSERT_TRUE(traversal.isFinished());
+}
+
+TEST(DepthFirstTraversalTest, yieldsBackEdgeClosingCycle)
+{
+	std::vector<Edge> edges = { {0, 1}, {1, 2}, {2, 0} };
+	UndirectedGraph graph(edges);
+
+	DepthFirstTraversal traversal(graph, graph.getVertexById(0));
+	auto events = collect(traversal);
+
+	ASSERT_THAT(events.size(), Eq(3u));
+	ASSERT_THAT(events.back().kind, Eq(EdgeKind::Back));
+	ASSERT_FALSE(events.back().target->isParentOf(events.back().source));
+	ASSERT_TRUE(isAncestor(events.back().target, events.back().source));
+}
+
+TEST(DepthFirstTraversalTest, resumesWhereItWasPaused)
+{
+	std::vector<Edge> edges = { {0, 1}, {0, 2}, {0, 3}, {1, 4}, {1, 5}, {4, 8}, {4, 9}, {3, 6}, {3, 7}, {6, 10}, {6, 11}, {5, 9} };
+	UndirectedGraph graph(edges);
+	DepthFirstTraversal uninterrupted(graph, graph.getVertexById(0));
+	auto expect = collect(uninterrupted);
+
+	DepthFirstTraversal traversal(graph, graph.getVertexById(0));
+	std::vector<TraversalEvent> actual;
+	TraversalEvent event;
+	for (int i = 0; i < 4 && traversal.next(event); ++i)
+		actual.push_back(event);
+	ASSERT_FALSE(traversal.isFinished());
+	auto rest = collect(traversal);
+	actual.insert(actual.end(), rest.begin(), rest.end());
+
+	ASSERT_THAT(actual.size(), Eq(expect.size()));
+	ASSERT_TRUE(std::equal(actual.begin(), actual.end(), expect.begin(), isSameEvent));
+}
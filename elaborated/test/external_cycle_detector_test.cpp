@@ -0,0 +1,135 @@
+#include <gmock/gmock.h>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+
+#include "external_cycle_detector.h"
+
+using ::testing::Eq;
+
+
+std::string writeEdgeFile(const std::string& name, const std::vector<Edge>& edges) {
+	auto path = ::testing::TempDir() + name;
+
+	std::FILE* file = std::fopen(path.c_str(), "wb");
+	assert(nullptr != file);
+	std::fwrite(edges.data(), sizeof(Edge), edges.size(), file);
+	std::fclose(file);
+
+	return path;
+}
+
+std::vector<Edge> makeRandomSimpleGraph(std::mt19937& random, int vertexCount, int edgeCount) {
+	std::uniform_int_distribution<int> pick(0, vertexCount - 1);
+	std::set<std::pair<int, int>> seen;
+	std::vector<Edge> edges;
+
+	while (static_cast<int>(edges.size()) < edgeCount) {
+		int source = pick(random);
+		int target = pick(random);
+		if (source == target || !seen.insert({ std::min(source, target), std::max(source, target) }).second)
+			continue;
+
+		edges.push_back({ source, target });
+	}
+
+	return edges;
+}
+
+const std::vector<Edge> edgesWithCycle = { {0, 1}, {0, 2}, {0, 3}, {1, 4}, {1, 5}, {4, 8}, {4, 9}, {3, 6}, {3, 7}, {6, 10}, {6, 11}, {5, 9} };
+const std::vector<Edge> edgesWithoutCycle = { {0, 1}, {0, 2}, {0, 3}, {1, 4}, {1, 5}, {4, 8}, {4, 9}, {3, 6}, {3, 7}, {6, 10}, {6, 11} };
+
+
+TEST(DisjointSetsTest, uniteReportsElementsAlreadyInSameSet) {
+	DisjointSets sets(3);
+
+	ASSERT_TRUE(sets.unite(0, 1));
+	ASSERT_TRUE(sets.unite(1, 2));
+
+	ASSERT_FALSE(sets.unite(0, 2));
+	ASSERT_THAT(sets.find(0), Eq(sets.find(2)));
+}
+
+TEST(EdgeFileReaderTest, readsAllEdgesInBlocks) {
+	auto path = writeEdgeFile("reader.edges", edgesWithCycle);
+	std::FILE* file = std::fopen(path.c_str(), "rb");
+
+	std::vector<Edge> edges;
+	{
+		EdgeFileReader reader(file, 5);
+		for (auto* block = &reader.nextBlock(); !block->empty(); block = &reader.nextBlock()) {
+			ASSERT_THAT(block->size() <= 5u, Eq(true));
+			edges.insert(edges.end(), block->begin(), block->end());
+		}
+	}
+	std::fclose(file);
+
+	ASSERT_THAT(edges.size(), Eq(edgesWithCycle.size()));
+	ASSERT_THAT(edges.back().source, Eq(5));
+	ASSERT_THAT(edges.back().target, Eq(9));
+}
+
+TEST(ExternalCycleDetectorTest, findsCycleInSinglePass) {
+	auto path = writeEdgeFile("with_cycle.edges", edgesWithCycle);
+	ExternalCycleDetector detector;
+
+	ASSERT_TRUE(detector.hasCycle(path, 12));
+	ASSERT_THAT(detector.passCount(), Eq(1u));
+}
+
+TEST(ExternalCycleDetectorTest, findsNoCycleInTree) {
+	auto path = writeEdgeFile("without_cycle.edges", edgesWithoutCycle);
+	ExternalCycleDetector detector;
+
+	ASSERT_FALSE(detector.hasCycle(path, 12));
+	ASSERT_THAT(detector.passCount(), Eq(1u));
+}
+
+TEST(ExternalCycleDetectorTest, scansForVertexCountWhenNotGiven) {
+	auto path = writeEdgeFile("with_cycle.edges", edgesWithCycle);
+	ExternalCycleDetector detector;
+
+	ASSERT_TRUE(detector.hasCycle(path));
+	ASSERT_THAT(detector.passCount(), Eq(2u));
+}
+
+TEST(ExternalCycleDetectorTest, ignoreSelfLoop) {
+	auto path = writeEdgeFile("self_loop.edges", { {0, 1}, {1, 1} });
+	ExternalCycleDetector detector;
+
+	ASSERT_FALSE(detector.hasCycle(path, 2));
+}
+
+TEST(ExternalCycleDetectorTest, rejectVertexIDOutOfRange) {
+	auto path = writeEdgeFile("out_of_range.edges", { {0, 5} });
+	ExternalCycleDetector detector;
+
+	ASSERT_THROW(detector.hasCycle(path, 3), std::out_of_range);
+}
+
+TEST(ExternalCycleDetectorTest, fallsBackToPartitionsWhenVerticesExceedBudget) {
+	auto withCycle = writeEdgeFile("with_cycle.edges", edgesWithCycle);
+	auto withoutCycle = writeEdgeFile("without_cycle.edges", edgesWithoutCycle);
+	ExternalCycleDetector detector(4 * 9, 4);
+
+	ASSERT_TRUE(detector.hasCycle(withCycle, 12));
+	ASSERT_THAT(detector.passCount() > 1u, Eq(true));
+
+	ASSERT_FALSE(detector.hasCycle(withoutCycle, 12));
+}
+
+TEST(ExternalCycleDetectorTest, partitionedAgreesWithSinglePassOnRandomGraphs) {
+	std::mt19937 random(26);
+	ExternalCycleDetector singlePass;
+	ExternalCycleDetector partitioned(3 * 9, 7);
+
+	for (int round = 0; round < 200; ++round) {
+		int vertexCount = 2 + round % 20;
+		int edgeCount = std::min(vertexCount * (vertexCount - 1) / 2, round % vertexCount + 1);
+		auto path = writeEdgeFile("random.edges", makeRandomSimpleGraph(random, vertexCount, edgeCount));
+
+		ASSERT_THAT(partitioned.hasCycle(path, vertexCount), Eq(singlePass.hasCycle(path, vertexCount)));
+	}
+}
@@ -0,0 +1,149 @@
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <vector>
+
+#include "compact_graph.h"
+#include "directed_graph.h"
+#include "graph_adapters.h"
+#include "graph_analysis.h"
+#include "small_graph.h"
+#include "spanning_forest.h"
+
+using ::testing::Eq;
+using ::testing::ElementsAre;
+
+using CsrGraph = CsrGraphView<std::uint32_t>;
+
+static_assert(IsIndexedGraph<CompactUndirectedGraph>::value, "compact graphs are indexed graphs");
+static_assert(IsIndexedGraph<CsrGraph>::value, "CSR views are indexed graphs");
+static_assert(IsIndexedGraph<EdgeSpanGraph<VertexID>>::value, "edge spans are indexed graphs");
+static_assert(!IsIndexedGraph<DirectedGraph>::value, "directed graphs list successors, not neighbors");
+static_assert(!IsIndexedGraph<SmallUndirectedGraph>::value, "small graphs list neighbors as masks");
+
+
+TEST(CsrGraphViewTest, searchCallerOwnedArrays) {
+	// A square 0-1-2-3 with a tail 3-4
+	const std::size_t offsets[] = { 0, 2, 4, 6, 9, 10 };
+	const std::uint32_t neighbors[] = { 1, 3, 0, 2, 1, 3, 0, 2, 4, 3 };
+	CsrGraph graph(5, offsets, neighbors);
+
+	SpanningForest<CsrGraph> forest(graph, 1);
+
+	ASSERT_TRUE(hasCycle(graph));
+	ASSERT_THAT(forest.fundamentalCycleCount(), Eq(1u));
+	ASSERT_THAT(graph.neighborsOf(3).begin(), Eq(neighbors + 6));
+}
+
+TEST(EdgeSpanGraphTest, listNeighborsFromSortedEdges) {
+	const Edge edges[] = { {0, 1}, {0, 2}, {1, 0}, {2, 0}, {2, 3}, {3, 2} };
+	EdgeSpanGraph<VertexID> graph(4, edges, 6);
+
+	ASSERT_THAT(std::vector<std::uint32_t>(graph.neighborsOf(2).begin(), graph.neighborsOf(2).end()), ElementsAre(0, 3));
+	ASSERT_FALSE(hasCycle(graph));
+
+	FusedTraversal<EdgeSpanGraph<VertexID>> traversal(graph);
+	ArticulationPointsPass<std::uint32_t> articulations;
+	traversal.registerPass(articulations);
+	traversal.run();
+
+	ASSERT_THAT(articulations.articulationPoints(), ElementsAre(0, 2));
+}
+
+TEST(ImplicitGraphTest, searchGridWithoutStoringIt) {
+	const std::uint32_t columns = 300;
+	auto makeGrid = [](std::uint32_t rows) {
+		return makeImplicitGraph<std::uint32_t>(rows * columns,
+			[rows](std::uint32_t vertex) {
+				auto row = vertex / columns, column = vertex % columns;
+				return (row > 0) + (row + 1 < rows) + (column > 0) + (column + 1 < columns);
+			},
+			[rows](std::uint32_t vertex, std::size_t position) {
+				auto row = vertex / columns, column = vertex % columns;
+				std::uint32_t candidates[4];
+				std::size_t count = 0;
+				if (row > 0)
+					candidates[count++] = vertex - columns;
+				if (row + 1 < rows)
+					candidates[count++] = vertex + columns;
+				if (column > 0)
+					candidates[count++] = vertex - 1;
+				if (column + 1 < columns)
+					candidates[count++] = vertex + 1;
+				return candidates[position];
+			});
+	};
+
+	ASSERT_FALSE(hasCycle(makeGrid(1)));
+	ASSERT_TRUE(hasCycle(makeGrid(2)));
+
+	auto grid = makeGrid(300);
+	SpanningForest<decltype(grid)> forest(grid, 2);
+
+	ASSERT_THAT(forest.componentCount(), Eq(1u));
+	ASSERT_THAT(forest.fundamentalCycleCount(), Eq(299u * 299u));
+}
+
+TEST(IndexedGraphTest, compactGraphAndAdapterAgree) {
+	CompactUndirectedGraph compact({ {0, 1}, {1, 2}, {2, 3}, {3, 1}, {4, 5} });
+	std::vector<std::size_t> offsets(1, 0);
+	std::vector<VertexIndex> neighbors;
+
+	for (VertexIndex vertex = 0; vertex < compact.vertexCount(); ++vertex) {
+		for (VertexIndex neighbor : compact.neighborsOf(vertex))
+			neighbors.push_back(neighbor);
+		offsets.push_back(neighbors.size());
+	}
+
+	CsrGraphView<VertexIndex> view(compact.vertexCount(), offsets.data(), neighbors.data());
+
+	ASSERT_THAT(hasCycle(view), Eq(hasCycle(compact)));
+	ASSERT_THAT(SpanningForest<decltype(view)>(view).fundamentalCycleCount(),
+		        Eq(SpanningForest<CompactUndirectedGraph>(compact).fundamentalCycleCount()));
+}
+
+TEST(IndexedGraphTest, selfLoopsAndRepeatedNeighborsMakeNoCycle) {
+	// A path 0-1-2 with the edge 0-1 listed twice and self-loops on 1 and 2
+	const std::size_t offsets[] = { 0, 2, 6, 8 };
+	const std::uint32_t neighbors[] = { 1, 1, 0, 1, 0, 2, 1, 2 };
+	CsrGraph graph(3, offsets, neighbors);
+
+	SpanningForest<CsrGraph> forest(graph, 1);
+	FusedTraversal<CsrGraph> traversal(graph);
+	CycleDetectionPass<std::uint32_t> cycles;
+	traversal.registerPass(cycles);
+	traversal.run();
+
+	ASSERT_FALSE(hasCycle(graph));
+	ASSERT_FALSE(cycles.hasCycle());
+	ASSERT_THAT(forest.fundamentalCycleCount(), Eq(0u));
+	ASSERT_TRUE(forest.fundamentalCycles().begin() == forest.fundamentalCycles().end());
+	ASSERT_THAT(forest.lowestCommonAncestor(0, 2), Eq(0u));
+}
+
+TEST(IndexedGraphTest, repeatedNeighborsInCycleAreCountedOnce) {
+	// A triangle with the edge 0-1 listed twice and a self-loop on 2
+	const std::size_t offsets[] = { 0, 3, 6, 9 };
+	const std::uint32_t neighbors[] = { 1, 2, 1, 0, 2, 0, 0, 1, 2 };
+	CsrGraph graph(3, offsets, neighbors);
+
+	SpanningForest<CsrGraph> forest(graph, 1);
+	std::size_t enumerated = 0;
+	std::vector<std::uint32_t> vertices;
+	for (auto&& cycle : forest.fundamentalCycles()) {
+		forest.traceCycle(cycle, vertices);
+		ASSERT_THAT(vertices.size(), Eq(3u));
+		++enumerated;
+	}
+
+	ASSERT_TRUE(hasCycle(graph));
+	ASSERT_THAT(forest.fundamentalCycleCount(), Eq(1u));
+	ASSERT_THAT(enumerated, Eq(1u));
+}
+
+TEST(EdgeSpanGraphTest, checkUnsortedEdgesInPlace) {
+	const Edge path[] = { {2, 3}, {0, 1}, {1, 1}, {1, 2} };
+	const Edge square[] = { {2, 3}, {0, 1}, {3, 0}, {1, 2} };
+
+	ASSERT_FALSE(hasCycle(4, path, 4));
+	ASSERT_TRUE(hasCycle(4, square, 4));
+}
@@ -0,0 +1,141 @@
+#include <gmock/gmock.h>
+#include <random>
+
+#include "compact_graph.h"
+#include "graph_analysis.h"
+
+using ::testing::Eq;
+using ::testing::ElementsAre;
+
+const VertexIndex noVertex = static_cast<VertexIndex>(-1);
+
+std::size_t countComponentsWithout(const CompactUndirectedGraph& graph, VertexIndex removed) {
+	std::vector<bool> seen(graph.vertexCount(), false);
+	std::size_t count = 0;
+
+	for (VertexIndex root = 0; root < graph.vertexCount(); ++root) {
+		if (root == removed || seen[root])
+			continue;
+
+		++count;
+		std::vector<VertexIndex> pending(1, root);
+		seen[root] = true;
+
+		while (!pending.empty()) {
+			auto vertex = pending.back();
+			pending.pop_back();
+
+			for (VertexIndex neighbor : graph.neighborsOf(vertex)) {
+				if (neighbor != removed && !seen[neighbor]) {
+					seen[neighbor] = true;
+					pending.push_back(neighbor);
+				}
+			}
+		}
+	}
+
+	return count;
+}
+
+bool isTwoColourable(const CompactUndirectedGraph& graph) {
+	std::vector<int> colours(graph.vertexCount(), -1);
+
+	for (VertexIndex root = 0; root < graph.vertexCount(); ++root) {
+		if (colours[root] >= 0)
+			continue;
+
+		std::vector<VertexIndex> queue(1, root);
+		colours[root] = 0;
+
+		for (std::size_t head = 0; head < queue.size(); ++head) {
+			auto vertex = queue[head];
+
+			for (VertexIndex neighbor : graph.neighborsOf(vertex)) {
+				if (colours[neighbor] == colours[vertex])
+					return false;
+
+				if (colours[neighbor] < 0) {
+					colours[neighbor] = 1 - colours[vertex];
+					queue.push_back(neighbor);
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+class FusedTraversalTest : public ::testing::Test {
+public:
+	void analyse(const CompactUndirectedGraph& graph) {
+		FusedTraversal<CompactUndirectedGraph> traversal(graph);
+		traversal.registerPass(cycles);
+		traversal.registerPass(components);
+		traversal.registerPass(bipartiteness);
+		traversal.registerPass(degrees);
+		traversal.registerPass(articulations);
+
+		traversal.run();
+	}
+
+	CycleDetectionPass<VertexIndex> cycles;
+	ConnectedComponentsPass<VertexIndex> components;
+	BipartitenessPass<VertexIndex> bipartiteness;
+	DegreeStatisticsPass<VertexIndex> degrees;
+	ArticulationPointsPass<VertexIndex> articulations;
+};
+
+
+TEST_F(FusedTraversalTest, analyseTreeAndSquareInOnePass) {
+	CompactUndirectedGraph graph({ {0, 1}, {1, 2}, {1, 3}, {4, 5}, {5, 6}, {6, 7}, {7, 4} });
+
+	analyse(graph);
+
+	ASSERT_TRUE(cycles.hasCycle());
+	ASSERT_THAT(components.componentCount(), Eq(2u));
+	ASSERT_THAT(components.componentOf(graph.indexOf(3)), Eq(components.componentOf(graph.indexOf(0))));
+	ASSERT_TRUE(bipartiteness.isBipartite());
+	ASSERT_THAT(degrees.minimumDegree(), Eq(1u));
+	ASSERT_THAT(degrees.maximumDegree(), Eq(3u));
+	ASSERT_THAT(degrees.averageDegree(), Eq(14.0 / 8));
+	ASSERT_THAT(articulations.articulationPoints(), ElementsAre(graph.indexOf(1)));
+}
+
+TEST_F(FusedTraversalTest, oddCycleIsNotBipartite) {
+	CompactUndirectedGraph graph({ {0, 1}, {1, 2}, {2, 0}, {2, 3} });
+
+	analyse(graph);
+
+	ASSERT_FALSE(bipartiteness.isBipartite());
+	ASSERT_THAT(articulations.articulationPoints(), ElementsAre(graph.indexOf(2)));
+}
+
+TEST_F(FusedTraversalTest, agreesWithSeparateAnalysesOnRandomGraphs) {
+	std::mt19937 random(33);
+	std::uniform_int_distribution<int> pickVertex(0, 39);
+
+	for (int round = 0; round < 50; ++round) {
+		std::vector<Edge> edges;
+		for (int i = 0; i < 45; ++i)
+			edges.push_back({ pickVertex(random), pickVertex(random) });
+
+		CompactUndirectedGraph graph(edges);
+		analyse(graph);
+
+		ASSERT_THAT(cycles.hasCycle(), Eq(hasCycle(graph)));
+		ASSERT_THAT(components.componentCount(), Eq(countComponentsWithout(graph, noVertex)));
+
+		ASSERT_THAT(bipartiteness.isBipartite(), Eq(isTwoColourable(graph)));
+
+		for (VertexIndex vertex = 0; vertex < graph.vertexCount(); ++vertex) {
+			if (bipartiteness.isBipartite()) {
+				for (VertexIndex neighbor : graph.neighborsOf(vertex))
+					ASSERT_NE(bipartiteness.sideOf(vertex), bipartiteness.sideOf(neighbor));
+			}
+
+			auto isolated = graph.neighborsOf(vertex).empty() ? 1u : 0u;
+			bool separates = countComponentsWithout(graph, vertex) > components.componentCount() - isolated;
+			ASSERT_THAT(articulations.isArticulationPoint(vertex), Eq(separates));
+		}
+	}
+}
@@ -0,0 +1,232 @@
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "query_server.h"
+#include "worker_pool.h"
+
+using ::testing::Eq;
+using ::testing::StartsWith;
+
+
+class QueryServerTest : public ::testing::Test {
+public:
+	QueryServerTest() : server(4) {
+		server.load("tree", { {0, 1}, {0, 2}, {0, 3}, {1, 4}, {1, 5}, {4, 8}, {4, 9}, {3, 6}, {3, 7}, {6, 10}, {6, 11} });
+		server.load("forest", { {0, 1}, {1, 2}, {5, 6}, {6, 7}, {7, 5} });
+	}
+
+	QueryServer server;
+};
+
+
+TEST(ResidentGraphTest, componentsAreRepresentedBySameVertex) {
+	ResidentGraph graph({ {0, 1}, {1, 2}, {5, 6} });
+
+	ASSERT_THAT(graph.componentOf(0), Eq(graph.componentOf(2)));
+	ASSERT_THAT(graph.componentSize(2), Eq(3u));
+	ASSERT_THAT(graph.componentSize(6), Eq(2u));
+	ASSERT_FALSE(graph.isReachable(1, 5));
+	ASSERT_FALSE(graph.hasCycle());
+}
+
+TEST(WorkerPoolTest, runsEverySubmittedTaskBeforeDestruction) {
+	std::atomic<int> runs(0);
+	{
+		WorkerPool pool(3);
+		for (int i = 0; i < 100; ++i)
+			pool.submit([&runs]() { ++runs; });
+	}
+
+	ASSERT_THAT(runs.load(), Eq(100));
+}
+
+TEST_F(QueryServerTest, answerCycleQueries) {
+	ASSERT_THAT(server.answer("cycle tree"), Eq("no"));
+	ASSERT_THAT(server.answer("cycle forest"), Eq("yes"));
+}
+
+TEST_F(QueryServerTest, answerReachabilityQueries) {
+	ASSERT_THAT(server.answer("reach tree 10 9"), Eq("yes"));
+	ASSERT_THAT(server.answer("reach forest 0 7"), Eq("no"));
+}
+
+TEST_F(QueryServerTest, answerComponentQueries) {
+	auto response = server.answer("component forest 7");
+
+	ASSERT_THAT(response, Eq(server.answer("component forest 5")));
+	ASSERT_THAT(response, testing::EndsWith(" 3"));
+}
+
+TEST_F(QueryServerTest, reportMalformedQueries) {
+	ASSERT_THAT(server.answer("colour tree"), Eq("error unknown command"));
+	ASSERT_THAT(server.answer("cycle"), Eq("error missing graph name"));
+	ASSERT_THAT(server.answer("cycle lattice"), Eq("error unknown graph lattice"));
+	ASSERT_THAT(server.answer("reach tree 0"), Eq("error missing vertex ID"));
+	ASSERT_THAT(server.answer("component tree 42"), Eq("error unknown vertex 42"));
+}
+
+TEST_F(QueryServerTest, answerStreamInQueryOrder) {
+	std::ostringstream queries;
+	std::ostringstream expect;
+	for (int i = 0; i < 200; ++i) {
+		queries << "reach forest 0 " << (i % 2 ? 2 : 5) << "\n";
+		expect << (i % 2 ? "yes" : "no") << "\n";
+	}
+	std::istringstream input(queries.str());
+	std::ostringstream output;
+
+	server.serve(input, output);
+
+	ASSERT_THAT(output.str(), Eq(expect.str()));
+}
+
+TEST_F(QueryServerTest, reportLatencyOfAnsweredQueries) {
+	server.answer("cycle tree");
+	server.answer("cycle forest");
+
+	ASSERT_THAT(server.latency().count, Eq(2u));
+	ASSERT_THAT(server.answer("stats"), StartsWith("queries 2 p50_us "));
+}
+
+class QueryServerSocketTest : public QueryServerTest {
+public:
+	QueryServerSocketTest() : socketPath("/tmp/query_server_test_" + std::to_string(::getpid()) + ".sock") {}
+
+	int connect() {
+		int client = ::socket(AF_UNIX, SOCK_STREAM, 0);
+		sockaddr_un address;
+		std::memset(&address, 0, sizeof(address));
+		address.sun_family = AF_UNIX;
+		std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+		timeval receiveTimeout = { 5, 0 };
+		::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &receiveTimeout, sizeof(receiveTimeout));
+
+		for (int attempt = 0; attempt < 500; ++attempt) {
+			if (::connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0)
+				return client;
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+
+		::close(client);
+		return -1;
+	}
+
+	static void send(int client, const std::string& data) {
+		ASSERT_THAT(::write(client, data.data(), data.size()), Eq(static_cast<ssize_t>(data.size())));
+	}
+
+	/*
+	 * @return the data received until the given number of lines has arrived or the
+	 *         connection was closed
+	 */
+	static std::string receive(int client, std::size_t lineCount) {
+		std::string received;
+		char chunk[256];
+
+		while (std::count(received.begin(), received.end(), '\n') < static_cast<std::ptrdiff_t>(lineCount)) {
+			auto count = ::read(client, chunk, sizeof(chunk));
+			if (count <= 0)
+				break;
+			received.append(chunk, static_cast<std::size_t>(count));
+		}
+
+		return received;
+	}
+
+	std::string socketPath;
+};
+
+
+TEST_F(QueryServerSocketTest, idleConnectionDoesNotBlockOthers) {
+	QueryServer singleWorker(1);
+	singleWorker.load("forest", { {0, 1}, {1, 2}, {5, 6}, {6, 7}, {7, 5} });
+	std::thread listener([&singleWorker, this]() { singleWorker.listen(socketPath); });
+
+	int first = connect();
+	ASSERT_GE(first, 0);
+	send(first, "cycle forest\n");
+	ASSERT_THAT(receive(first, 1), Eq("yes\n"));
+
+	int second = connect();
+	ASSERT_GE(second, 0);
+	send(second, "reach forest 0 2\nreach forest 0 5\n");
+	ASSERT_THAT(receive(second, 2), Eq("yes\nno\n"));
+
+	send(first, "quit\n");
+	ASSERT_THAT(receive(first, 1), Eq(""));
+
+	singleWorker.stop();
+	listener.join();
+	::close(first);
+	::close(second);
+
+	ASSERT_THAT(singleWorker.latency().count, Eq(3u));
+	ASSERT_NE(::access(socketPath.c_str(), F_OK), 0);
+}
+
+TEST_F(QueryServerSocketTest, closeConnectionSendingOverlongQuery) {
+	std::thread listener([this]() { server.listen(socketPath); });
+
+	int client = connect();
+	ASSERT_GE(client, 0);
+	send(client, "cycle tree\n" + std::string(QueryServer::maxQueryLength + 1, 'x'));
+
+	ASSERT_THAT(receive(client, 3), Eq("no\nerror query too long\n"));
+
+	server.stop();
+	listener.join();
+	::close(client);
+}
+
+TEST_F(QueryServerTest, stopBeforeListenReturnsImmediately) {
+	auto socketPath = "/tmp/query_server_stop_" + std::to_string(::getpid()) + ".sock";
+
+	server.stop();
+	server.listen(socketPath);
+
+	ASSERT_NE(::access(socketPath.c_str(), F_OK), 0);
+}
+
+TEST_F(QueryServerSocketTest, stoppedServerListensAgain) {
+	server.stop();
+	server.listen(socketPath);
+
+	for (int round = 0; round < 2; ++round) {
+		std::thread listener([this]() { server.listen(socketPath); });
+
+		int client = connect();
+		ASSERT_GE(client, 0);
+		send(client, "cycle tree\n");
+		auto response = receive(client, 1);
+
+		server.stop();
+		listener.join();
+		::close(client);
+
+		ASSERT_THAT(response, Eq("no\n"));
+		ASSERT_NE(::access(socketPath.c_str(), F_OK), 0);
+	}
+}
+
+TEST_F(QueryServerTest, listenKeepsFileThatIsNotSocket) {
+	auto path = "/tmp/query_server_file_" + std::to_string(::getpid()) + ".txt";
+	std::ofstream(path) << "precious\n";
+
+	ASSERT_THROW(server.listen(path), std::runtime_error);
+
+	std::string content;
+	std::getline(std::ifstream(path), content);
+	::unlink(path.c_str());
+	ASSERT_THAT(content, Eq("precious"));
+}
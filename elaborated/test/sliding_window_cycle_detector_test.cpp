@@ -0,0 +1,123 @@
+#include <gmock/gmock.h>
+#include <map>
+#include <random>
+#include <utility>
+
+#include "sliding_window_cycle_detector.h"
+#include "compact_graph.h"
+
+using ::testing::Eq;
+using ::testing::ElementsAre;
+using ::testing::Pair;
+
+
+bool liveEdgesHaveCycle(const std::map<std::pair<int, int>, std::int64_t>& lastSeen,
+	                    std::int64_t now, std::int64_t window) {
+	std::vector<Edge> live;
+	for (auto&& item : lastSeen) {
+		if (item.second + window > now)
+			live.push_back({ item.first.first, item.first.second });
+	}
+
+	return hasCycle(CompactUndirectedGraph(live));
+}
+
+class SlidingWindowCycleDetectorTest : public ::testing::Test {
+public:
+	SlidingWindowCycleDetectorTest() : detector(10) {
+		detector.registerCycleListener([this](CycleEvent event, SlidingWindowCycleDetector::Timestamp time) {
+			events.push_back({ event, time });
+		});
+	}
+
+	SlidingWindowCycleDetector detector;
+	std::vector<std::pair<CycleEvent, SlidingWindowCycleDetector::Timestamp>> events;
+};
+
+
+TEST_F(SlidingWindowCycleDetectorTest, cycleAppearsWhenClosingEdgeArrives) {
+	detector.insert({ 0, 1 }, 1);
+	detector.insert({ 1, 2 }, 2);
+	ASSERT_FALSE(detector.hasCycle());
+
+	detector.insert({ 2, 0 }, 3);
+
+	ASSERT_TRUE(detector.hasCycle());
+	ASSERT_THAT(events, ElementsAre(Pair(CycleEvent::Appeared, 3)));
+}
+
+TEST_F(SlidingWindowCycleDetectorTest, cycleDisappearsWhenOldestEdgeExpires) {
+	detector.insert({ 0, 1 }, 1);
+	detector.insert({ 1, 2 }, 2);
+	detector.insert({ 2, 0 }, 3);
+
+	detector.advanceTo(10);
+	ASSERT_TRUE(detector.hasCycle());
+	detector.advanceTo(11);
+
+	ASSERT_FALSE(detector.hasCycle());
+	ASSERT_THAT(detector.edgeCount(), Eq(2u));
+	ASSERT_THAT(events, ElementsAre(Pair(CycleEvent::Appeared, 3), Pair(CycleEvent::Disappeared, 11)));
+}
+
+TEST_F(SlidingWindowCycleDetectorTest, renewedEdgeKeepsCycleAlive) {
+	detector.insert({ 0, 1 }, 1);
+	detector.insert({ 1, 2 }, 2);
+	detector.insert({ 2, 0 }, 3);
+
+	detector.insert({ 1, 0 }, 9);
+	detector.advanceTo(11);
+
+	ASSERT_TRUE(detector.hasCycle());
+	detector.advanceTo(12);
+	ASSERT_FALSE(detector.hasCycle());
+}
+
+TEST_F(SlidingWindowCycleDetectorTest, repeatedEdgeIsNotCycle) {
+	detector.insert({ 0, 1 }, 1);
+	detector.insert({ 1, 0 }, 2);
+	detector.insert({ 1, 1 }, 3);
+
+	ASSERT_FALSE(detector.hasCycle());
+	ASSERT_THAT(detector.edgeCount(), Eq(1u));
+	ASSERT_TRUE(events.empty());
+}
+
+TEST(SlidingWindowCycleDetectorRandomTest, agreesWithRecomputationOverWindow) {
+	const std::int64_t window = 25;
+	std::mt19937 random(31);
+	std::uniform_int_distribution<int> pickVertex(0, 19);
+	std::uniform_int_distribution<int> pickStep(0, 3);
+
+	SlidingWindowCycleDetector detector(window);
+	std::map<std::pair<int, int>, std::int64_t> lastSeen;
+	bool expectCycle = false;
+	int expectTransitions = 0;
+	int transitions = 0;
+	detector.registerCycleListener([&transitions](CycleEvent event, SlidingWindowCycleDetector::Timestamp time) {
+		++transitions;
+	});
+
+	std::int64_t now = 0;
+	for (int step = 0; step < 5000; ++step) {
+		now += pickStep(random);
+		int source = pickVertex(random);
+		int target = pickVertex(random);
+
+		detector.advanceTo(now);
+		bool afterExpiry = liveEdgesHaveCycle(lastSeen, now, window);
+		ASSERT_THAT(detector.hasCycle(), Eq(afterExpiry));
+
+		detector.insert({ source, target }, now);
+		if (source != target)
+			lastSeen[{ std::min(source, target), std::max(source, target) }] = now;
+		bool afterInsertion = liveEdgesHaveCycle(lastSeen, now, window);
+		ASSERT_THAT(detector.hasCycle(), Eq(afterInsertion));
+
+		expectTransitions += (afterExpiry != expectCycle ? 1 : 0) + (afterInsertion != afterExpiry ? 1 : 0);
+		expectCycle = afterInsertion;
+	}
+
+	ASSERT_THAT(transitions, Eq(expectTransitions));
+	ASSERT_THAT(transitions > 10, Eq(true));
+}
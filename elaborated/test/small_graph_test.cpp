@@ -0,0 +1,64 @@
+#include <gmock/gmock.h>
+#include <random>
+
+#include "compact_graph.h"
+#include "small_graph.h"
+
+using ::testing::Eq;
+
+constexpr Edge triangleWithTail[] = { {7, 8}, {8, 9}, {9, 7}, {9, 10} };
+constexpr Edge twoPaths[] = { {7, 8}, {8, 9}, {20, 21}, {21, 21}, {8, 7} };
+
+static_assert(hasCycle(SmallUndirectedGraph(triangleWithTail)), "a triangle is a cycle");
+static_assert(!hasCycle(SmallUndirectedGraph(twoPaths)), "paths, self-loops and repeated edges are not cycles");
+static_assert(SmallUndirectedGraph(twoPaths).componentCount() == 2, "two paths are two components");
+
+
+SmallUndirectedGraph makeSmallGraph(const std::vector<Edge>& edges) {
+	return SmallUndirectedGraph(edges.data(), edges.data() + edges.size());
+}
+
+TEST(SmallUndirectedGraphTest, mapIdsInOrderOfAppearance) {
+	auto graph = makeSmallGraph({ {40, 3}, {3, 1000} });
+
+	ASSERT_THAT(graph.vertexCount(), Eq(3u));
+	ASSERT_THAT(graph.indexOf(3), Eq(1u));
+	ASSERT_THAT(graph.idOf(2), Eq(1000));
+	ASSERT_FALSE(graph.hasVertex(4));
+	ASSERT_THAT(graph.neighborsOf(graph.indexOf(3)), Eq(SmallUndirectedGraph::Mask(0b101)));
+}
+
+TEST(SmallUndirectedGraphTest, sixtyFourVerticesFit) {
+	std::vector<Edge> edges;
+	for (int vertex = 1; vertex < 64; ++vertex)
+		edges.push_back({ vertex - 1, vertex });
+
+	ASSERT_TRUE(makeSmallGraph(edges).fits());
+	ASSERT_FALSE(makeSmallGraph(edges).hasCycle());
+
+	edges.push_back({ 63, 0 });
+	ASSERT_TRUE(makeSmallGraph(edges).hasCycle());
+
+	edges.push_back({ 63, 64 });
+	ASSERT_FALSE(makeSmallGraph(edges).fits());
+}
+
+TEST(SmallUndirectedGraphTest, agreesWithCompactGraphOnRandomGraphs) {
+	std::mt19937 random(34);
+	std::uniform_int_distribution<int> pickVertex(0, 63);
+	std::uniform_int_distribution<int> pickEdgeCount(0, 70);
+
+	for (int round = 0; round < 500; ++round) {
+		std::vector<Edge> edges(pickEdgeCount(random));
+		for (auto& edge : edges)
+			edge = { pickVertex(random), pickVertex(random) };
+
+		auto small = makeSmallGraph(edges);
+		CompactUndirectedGraph compact(edges);
+
+		ASSERT_TRUE(small.fits());
+		ASSERT_THAT(small.vertexCount(), Eq(compact.vertexCount()));
+		ASSERT_THAT(small.edgeCount(), Eq(compact.edgeCount()));
+		ASSERT_THAT(hasCycle(small), Eq(hasCycle(compact)));
+	}
+}
@@ -0,0 +1,123 @@
+#include <gmock/gmock.h>
+#include <random>
+#include <set>
+#include <utility>
+
+#include "compact_graph.h"
+#include "spanning_forest.h"
+
+using ::testing::Eq;
+using ::testing::ElementsAre;
+
+using Forest = SpanningForest<CompactUndirectedGraph>;
+
+
+TEST(SpanningForestTest, treeHasNoFundamentalCycle) {
+	CompactUndirectedGraph graph({ {0, 1}, {1, 2}, {1, 3}, {5, 6} });
+	Forest forest(graph);
+
+	ASSERT_THAT(forest.componentCount(), Eq(2u));
+	ASSERT_THAT(forest.fundamentalCycleCount(), Eq(0u));
+	ASSERT_TRUE(forest.fundamentalCycles().begin() == forest.fundamentalCycles().end());
+	ASSERT_THAT(forest.parentOf(graph.indexOf(2)), Eq(graph.indexOf(1)));
+	ASSERT_THAT(forest.depthOf(graph.indexOf(3)), Eq(2u));
+	ASSERT_THAT(forest.rootOf(graph.indexOf(6)), Eq(graph.indexOf(5)));
+}
+
+TEST(SpanningForestTest, lowestCommonAncestorOfBranches) {
+	CompactUndirectedGraph graph({ {0, 1}, {0, 2}, {1, 3}, {1, 4}, {2, 5} });
+	Forest forest(graph, 1);
+
+	ASSERT_THAT(forest.lowestCommonAncestor(graph.indexOf(3), graph.indexOf(4)), Eq(graph.indexOf(1)));
+	ASSERT_THAT(forest.lowestCommonAncestor(graph.indexOf(4), graph.indexOf(5)), Eq(graph.indexOf(0)));
+	ASSERT_THAT(forest.lowestCommonAncestor(graph.indexOf(1), graph.indexOf(3)), Eq(graph.indexOf(1)));
+	ASSERT_THAT(forest.lowestCommonAncestor(graph.indexOf(2), graph.indexOf(2)), Eq(graph.indexOf(2)));
+}
+
+TEST(SpanningForestTest, traceTriangle) {
+	CompactUndirectedGraph graph({ {0, 1}, {1, 2}, {2, 0} });
+	Forest forest(graph);
+	std::vector<VertexIndex> vertices;
+
+	ASSERT_THAT(forest.fundamentalCycleCount(), Eq(1u));
+
+	auto cycle = *forest.fundamentalCycles().begin();
+	forest.traceCycle(cycle, vertices);
+
+	ASSERT_THAT(cycle.source, Eq(graph.indexOf(1)));
+	ASSERT_THAT(cycle.target, Eq(graph.indexOf(2)));
+	ASSERT_THAT(vertices, ElementsAre(graph.indexOf(1), graph.indexOf(0), graph.indexOf(2)));
+}
+
+TEST(SpanningForestRandomTest, everyCycleIsClosedBySpanningForest) {
+	std::mt19937 random(32);
+	std::uniform_int_distribution<int> pickVertex(0, 299);
+
+	std::vector<Edge> edges;
+	for (int i = 0; i < 400; ++i)
+		edges.push_back({ pickVertex(random), pickVertex(random) });
+
+	CompactUndirectedGraph graph(edges);
+	Forest forest(graph, 4);
+	std::set<std::pair<VertexIndex, VertexIndex>> arcs;
+	for (VertexIndex vertex = 0; vertex < graph.vertexCount(); ++vertex) {
+		for (VertexIndex neighbor : graph.neighborsOf(vertex))
+			arcs.insert({ vertex, neighbor });
+	}
+
+	std::size_t count = 0;
+	std::vector<VertexIndex> vertices;
+	for (auto&& cycle : forest.fundamentalCycles()) {
+		forest.traceCycle(cycle, vertices);
+		++count;
+
+		ASSERT_THAT(forest.rootOf(cycle.source), Eq(forest.rootOf(cycle.target)));
+		ASSERT_THAT(std::set<VertexIndex>(vertices.begin(), vertices.end()).size(), Eq(vertices.size()));
+		ASSERT_TRUE(arcs.count({ vertices.back(), vertices.front() }));
+		for (std::size_t i = 1; i < vertices.size(); ++i)
+			ASSERT_TRUE(arcs.count({ vertices[i - 1], vertices[i] }));
+	}
+
+	ASSERT_THAT(count, Eq(forest.fundamentalCycleCount()));
+	ASSERT_THAT(count, Eq(graph.edgeCount() - graph.vertexCount() + forest.componentCount()));
+	ASSERT_THAT(count > 0, Eq(true));
+}
+
+TEST(SpanningForestRandomTest, lowestCommonAncestorsInComponentsOfMixedSizes) {
+	std::mt19937 random(320);
+	std::vector<Edge> edges;
+
+	// One large random tree, followed by many small ones
+	for (int vertex = 1; vertex < 500; ++vertex)
+		edges.push_back({ std::uniform_int_distribution<int>(0, vertex - 1)(random), vertex });
+	for (int base = 1000; base < 1300; base += 3) {
+		edges.push_back({ base, base + 1 });
+		edges.push_back({ base, base + 2 });
+	}
+
+	CompactUndirectedGraph graph(edges);
+	Forest forest(graph, 3);
+	std::uniform_int_distribution<VertexIndex> pickVertex(0, static_cast<VertexIndex>(graph.vertexCount() - 1));
+
+	auto climb = [&forest](VertexIndex u, VertexIndex v) {
+		while (forest.depthOf(u) > forest.depthOf(v))
+			u = forest.parentOf(u);
+		while (forest.depthOf(v) > forest.depthOf(u))
+			v = forest.parentOf(v);
+		while (u != v) {
+			u = forest.parentOf(u);
+			v = forest.parentOf(v);
+		}
+		return u;
+	};
+
+	ASSERT_THAT(forest.componentCount(), Eq(101u));
+	for (int i = 0; i < 20000; ++i) {
+		auto u = pickVertex(random);
+		auto v = pickVertex(random);
+
+		if (forest.rootOf(u) == forest.rootOf(v)) {
+			ASSERT_THAT(forest.lowestCommonAncestor(u, v), Eq(climb(u, v)));
+		}
+	}
+}
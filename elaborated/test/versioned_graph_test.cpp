@@ -0,0 +1,129 @@
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "versioned_graph.h"
+
+using ::testing::Eq;
+using ::testing::ElementsAre;
+
+
+std::vector<VertexID> neighborIdsOf(const GraphVersion& version, VertexID id) {
+	std::vector<VertexID> ids;
+	for (VertexIndex neighbor : version.neighborsOf(version.indexOf(id)))
+		ids.push_back(version.idOf(neighbor));
+
+	std::sort(ids.begin(), ids.end());
+	return ids;
+}
+
+TEST(VersionedGraphTest, pinnedVersionIsUnchangedByUpdates) {
+	VersionedGraph graph({ {0, 1}, {1, 2} });
+	auto before = graph.pin();
+
+	graph.addEdges({ {2, 0}, {2, 3} });
+	auto after = graph.pin();
+
+	ASSERT_FALSE(hasCycle(*before));
+	ASSERT_THAT(before->edgeCount(), Eq(2u));
+	ASSERT_FALSE(before->hasVertex(3));
+	ASSERT_TRUE(hasCycle(*after));
+	ASSERT_THAT(after->edgeCount(), Eq(4u));
+	ASSERT_THAT(neighborIdsOf(*after, 2), ElementsAre(0, 1, 3));
+	ASSERT_THAT(after->number(), Eq(before->number() + 1));
+}
+
+TEST(VersionedGraphTest, removeEdgesKeepsVertices) {
+	VersionedGraph graph({ {0, 1}, {1, 2}, {2, 0} });
+
+	graph.removeEdges({ {1, 0}, {5, 6}, {2, 2} });
+	auto version = graph.pin();
+
+	ASSERT_FALSE(hasCycle(*version));
+	ASSERT_THAT(version->vertexCount(), Eq(3u));
+	ASSERT_THAT(version->edgeCount(), Eq(2u));
+	ASSERT_TRUE(version->neighborsOf(version->indexOf(0)).size() == 1);
+}
+
+TEST(VersionedGraphTest, unchangedBlocksAreShared) {
+	std::vector<Edge> path;
+	for (VertexID vertex = 1; vertex < 3 * static_cast<VertexID>(GraphVersion::blockSize); ++vertex)
+		path.push_back({ vertex - 1, vertex });
+
+	VersionedGraph graph(path);
+	auto before = graph.pin();
+	auto after = graph.addEdges({ {0, 2} });
+
+	ASSERT_TRUE(hasCycle(*after));
+	ASSERT_THAT(after->neighborsOf(after->indexOf(2 * GraphVersion::blockSize)).begin(),
+		        Eq(before->neighborsOf(before->indexOf(2 * GraphVersion::blockSize)).begin()));
+	ASSERT_FALSE(after->neighborsOf(0).begin() == before->neighborsOf(0).begin());
+}
+
+TEST(VersionedGraphTest, indexStaysConsistentAsItGrows) {
+	VersionedGraph graph;
+	auto small = graph.addEdges({ {-7, 7} });
+
+	for (VertexID vertex = 1; vertex < 5 * static_cast<VertexID>(GraphVersion::blockSize); vertex += 64) {
+		std::vector<Edge> batch;
+		for (VertexID id = vertex; id < vertex + 64; ++id)
+			batch.push_back({ 1000 * (id - 1), 1000 * id });
+
+		graph.addEdges(batch);
+	}
+
+	auto large = graph.pin();
+
+	ASSERT_THAT(small->vertexCount(), Eq(2u));
+	ASSERT_FALSE(small->hasVertex(0));
+	ASSERT_THAT(small->idOf(small->indexOf(7)), Eq(7));
+	for (VertexIndex index = 0; index < large->vertexCount(); ++index)
+		ASSERT_THAT(large->indexOf(large->idOf(index)), Eq(index));
+	ASSERT_TRUE(large->hasVertex(-7));
+	ASSERT_FALSE(large->hasVertex(500));
+}
+
+TEST(VersionedGraphTest, versionIsReclaimedOnceUnpinned) {
+	VersionedGraph graph({ {0, 1} });
+	std::weak_ptr<const GraphVersion> old = graph.pin();
+
+	ASSERT_FALSE(old.expired());
+	graph.addEdges({ {1, 2} });
+
+	ASSERT_TRUE(old.expired());
+}
+
+TEST(VersionedGraphTest, readersSeeConsistentVersionsDuringUpdates) {
+	VersionedGraph graph({ {0, 1} });
+	std::atomic<bool> bDone(false);
+	std::atomic<int> inconsistencies(0);
+
+	std::vector<std::thread> readers;
+	for (int i = 0; i < 4; ++i) {
+		readers.emplace_back([&graph, &bDone, &inconsistencies]() {
+			while (!bDone) {
+				auto version = graph.pin();
+				std::size_t arcs = 0;
+				for (VertexIndex vertex = 0; vertex < version->vertexCount(); ++vertex)
+					arcs += version->neighborsOf(vertex).size();
+
+				// Versions hold a path over every vertex, closed into a ring on even versions.
+				bool bRing = version->number() % 2 == 0;
+				if (arcs != 2 * version->edgeCount() || hasCycle(*version) != bRing)
+					++inconsistencies;
+			}
+		});
+	}
+
+	for (VertexID vertex = 2; vertex < 500; ++vertex) {
+		graph.addEdges({ {vertex - 1, vertex}, {vertex, 0} });
+		graph.removeEdges({ {vertex, 0} });
+	}
+	bDone = true;
+
+	for (auto&& reader : readers)
+		reader.join();
+
+	ASSERT_THAT(inconsistencies.load(), Eq(0));
+}